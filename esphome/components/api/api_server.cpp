@@ -2,6 +2,7 @@
 #include "api_connection.h"
 #include "esphome/core/application.h"
 #include "esphome/core/defines.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/core/util.h"
 #include "esphome/core/version.h"
@@ -285,15 +286,54 @@ void APIServer::send_homeassistant_service_call(const HomeassistantServiceRespon
 APIServer::APIServer() { global_api_server = this; }
 void APIServer::subscribe_home_assistant_state(std::string entity_id, optional<std::string> attribute,
                                                std::function<void(std::string)> f) {
+  auto *sub = this->find_state_sub_(entity_id, attribute.value());
+  if (sub != nullptr) {
+    sub->callbacks.push_back(std::move(f));
+    // The new callback hasn't seen the current state yet, so don't skip it the next time it's received
+    sub->last_state.reset();
+    return;
+  }
+
+  uint32_t key = state_sub_key_(entity_id, attribute.value());
+  this->state_sub_index_.emplace(key, this->state_subs_.size());
   this->state_subs_.push_back(HomeAssistantStateSubscription{
       .entity_id = std::move(entity_id),
       .attribute = std::move(attribute),
-      .callback = std::move(f),
+      .callbacks = {std::move(f)},
+      .last_state = {},
   });
 }
 const std::vector<APIServer::HomeAssistantStateSubscription> &APIServer::get_state_subs() const {
   return this->state_subs_;
 }
+void APIServer::on_home_assistant_state(const std::string &entity_id, const std::string &attribute,
+                                        const std::string &state) {
+  auto *sub = this->find_state_sub_(entity_id, attribute);
+  if (sub == nullptr || (sub->last_state.has_value() && *sub->last_state == state))
+    return;
+  sub->last_state = state;
+  for (auto &callback : sub->callbacks)
+    callback(state);
+}
+uint32_t APIServer::state_sub_key_(const std::string &entity_id, const std::string &attribute) {
+  // Separated, so that "a" + "bc" and "ab" + "c" have different keys
+  std::string key;
+  key.reserve(entity_id.size() + 1 + attribute.size());
+  key += entity_id;
+  key += '\0';
+  key += attribute;
+  return fnv1_hash(key);
+}
+APIServer::HomeAssistantStateSubscription *APIServer::find_state_sub_(const std::string &entity_id,
+                                                                      const std::string &attribute) {
+  auto range = this->state_sub_index_.equal_range(state_sub_key_(entity_id, attribute));
+  for (auto it = range.first; it != range.second; ++it) {
+    auto &sub = this->state_subs_[it->second];
+    if (sub.entity_id == entity_id && sub.attribute.value() == attribute)
+      return &sub;
+  }
+  return nullptr;
+}
 uint16_t APIServer::get_port() const { return this->port_; }
 void APIServer::set_reboot_timeout(uint32_t reboot_timeout) { this->reboot_timeout_ = reboot_timeout; }
 #ifdef USE_HOMEASSISTANT_TIME
@@ -7,12 +7,14 @@
 #include "esphome/components/socket/socket.h"
 #include "api_pb2.h"
 #include "api_pb2_service.h"
-#include "util.h"
+#include "esphome/core/component_iterator.h"
 #include "list_entities.h"
 #include "subscribe_state.h"
 #include "user_services.h"
 #include "api_noise_context.h"
 
+#include <unordered_map>
+
 namespace esphome {
 namespace api {
 
@@ -78,18 +80,27 @@ class APIServer : public Component, public Controller {
 
   bool is_connected() const;
 
+  /// A Home Assistant entity (attribute) that is subscribed to, shared by everything that subscribed to it.
   struct HomeAssistantStateSubscription {
     std::string entity_id;
     optional<std::string> attribute;
-    std::function<void(std::string)> callback;
+    std::vector<std::function<void(std::string)>> callbacks;
+    /// The state that was last passed to the callbacks, used to skip updates that don't change it.
+    optional<std::string> last_state;
   };
 
   void subscribe_home_assistant_state(std::string entity_id, optional<std::string> attribute,
                                       std::function<void(std::string)> f);
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
+  /// Pass a state received from Home Assistant to the callbacks subscribed to it, unless the state didn't change.
+  void on_home_assistant_state(const std::string &entity_id, const std::string &attribute, const std::string &state);
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
  protected:
+  static uint32_t state_sub_key_(const std::string &entity_id, const std::string &attribute);
+  /// Find the subscription for an entity id and attribute, an empty attribute means the state itself.
+  HomeAssistantStateSubscription *find_state_sub_(const std::string &entity_id, const std::string &attribute);
+
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
@@ -97,6 +108,8 @@ class APIServer : public Component, public Controller {
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
   std::vector<HomeAssistantStateSubscription> state_subs_;
+  /// Index into state_subs_ by the hash of entity id and attribute, see state_sub_key_().
+  std::unordered_multimap<uint32_t, size_t> state_sub_index_;
   std::vector<UserServiceDescriptor *> user_services_;
 
 #ifdef USE_API_NOISE
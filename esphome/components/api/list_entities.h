@@ -2,16 +2,17 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
-#include "util.h"
+#include "esphome/core/component_iterator.h"
 
 namespace esphome {
 namespace api {
 
 class APIConnection;
+class UserServiceDescriptor;
 
 class ListEntitiesIterator : public ComponentIterator {
  public:
-  ListEntitiesIterator(APIServer *server, APIConnection *client);
+  ListEntitiesIterator(APIConnection *client);
 #ifdef USE_BINARY_SENSOR
   bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) override;
 #endif
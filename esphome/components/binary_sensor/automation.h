@@ -129,6 +129,10 @@ class StateTrigger : public Trigger<bool> {
 template<typename... Ts> class BinarySensorCondition : public Condition<Ts...> {
  public:
   BinarySensorCondition(BinarySensor *parent, bool state) : parent_(parent), state_(state) {}
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    this->parent_->add_on_state_callback([callback](bool state) { callback(); });
+    return true;
+  }
   bool check(Ts... x) override { return this->parent_->state == this->state_; }
 
  protected:
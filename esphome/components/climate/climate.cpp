@@ -319,8 +319,8 @@ void Climate::add_on_state_callback(std::function<void()> &&callback) {
 static const uint32_t RESTORE_STATE_VERSION = 0x848EA6ADUL;
 
 optional<ClimateDeviceRestoreState> Climate::restore_state_() {
-  this->rtc_ = global_preferences->make_preference<ClimateDeviceRestoreState>(this->get_object_id_hash() ^
-                                                                              RESTORE_STATE_VERSION);
+  this->rtc_ = global_state_journal.make_record<ClimateDeviceRestoreState>(this->get_object_id_hash() ^
+                                                                           RESTORE_STATE_VERSION);
   ClimateDeviceRestoreState recovered{};
   if (!this->rtc_.load(&recovered))
     return {};
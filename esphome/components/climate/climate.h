@@ -4,6 +4,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/state_journal.h"
 #include "esphome/core/log.h"
 #include "climate_mode.h"
 #include "climate_traits.h"
@@ -286,7 +287,7 @@ class Climate : public EntityBase {
   void dump_traits_(const char *tag);
 
   CallbackManager<void()> state_callback_{};
-  ESPPreferenceObject rtc_;
+  StateJournalRecord rtc_;
   optional<float> visual_min_temperature_override_{};
   optional<float> visual_max_temperature_override_{};
   optional<float> visual_temperature_step_override_{};
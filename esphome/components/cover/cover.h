@@ -4,6 +4,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/state_journal.h"
 #include "cover_traits.h"
 
 namespace esphome {
@@ -182,7 +183,7 @@ class Cover : public EntityBase {
   CallbackManager<void()> state_callback_{};
   optional<std::string> device_class_override_{};
 
-  ESPPreferenceObject rtc_;
+  StateJournalRecord rtc_;
 };
 
 }  // namespace cover
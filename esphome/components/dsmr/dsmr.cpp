@@ -2,18 +2,32 @@
 
 #include "dsmr.h"
 #include "esphome/core/log.h"
+#include "esphome/core/helpers.h"
 
-#include <AES.h>
 #include <Crypto.h>
-#include <GCM.h>
+#include <algorithm>
+#include <cstring>
 
 namespace esphome {
 namespace dsmr {
 
 static const char *const TAG = "dsmr";
 
+/// Size of the ciphertext chunks that are decrypted at once.
+static const size_t CHUNK_SIZE = 64;
+/// Size of the GCM authentication tag at the end of an encrypted telegram.
+static const size_t CRYPT_TAG_SIZE = 12;
+
+/// CRC16/ARC as used by the checksum at the end of a telegram.
+static uint16_t crc16_update(uint16_t crc, uint8_t byte) {
+  crc ^= byte;
+  for (uint8_t i = 0; i < 8; i++)
+    crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+  return crc;
+}
+
 void Dsmr::setup() {
-  this->telegram_ = new char[this->max_telegram_len_];  // NOLINT
+  this->line_ = new char[this->max_line_len_];  // NOLINT
   if (this->request_pin_ != nullptr) {
     this->request_pin_->setup();
   }
@@ -68,7 +82,7 @@ bool Dsmr::available_within_timeout_() {
   }
   // When we're not in the process of reading a telegram, then there is
   // no need to actively wait for new data to come in.
-  if (!header_found_) {
+  if (!this->header_found_ && this->crypt_bytes_read_ == 0) {
     return false;
   }
   // A telegram is being read. The smart meter might not deliver a telegram
@@ -133,147 +147,230 @@ void Dsmr::reset_telegram_() {
   this->last_read_time_ = 0;
 }
 
+void Dsmr::start_telegram_() {
+  this->header_found_ = true;
+  this->footer_found_ = false;
+  this->bytes_read_ = 0;
+  this->line_len_ = 0;
+  this->line_complete_ = false;
+  this->line_overflow_ = false;
+  this->first_line_ = true;
+  this->telegram_error_ = false;
+  this->crc_ = 0;
+  this->crc_len_ = 0;
+
+#define DSMR_RESET_SENSOR(s) this->data_.s##_present = false;
+  DSMR_SENSOR_LIST(DSMR_RESET_SENSOR, )
+  DSMR_TEXT_SENSOR_LIST(DSMR_RESET_SENSOR, )
+}
+
 void Dsmr::receive_telegram_() {
+  uint8_t buf[CHUNK_SIZE];
   while (this->available_within_timeout_()) {
-    const char c = this->read();
-
-    // Find a new telegram header, i.e. forward slash.
-    if (c == '/') {
-      ESP_LOGV(TAG, "Header of telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
+    size_t len = this->read_available(buf, sizeof(buf));
+    for (size_t i = 0; i < len; i++) {
+      if (this->process_telegram_byte_(buf[i])) {
+        this->reset_telegram_();
+        return;
+      }
     }
-    if (!this->header_found_)
-      continue;
+  }
+}
 
-    // Check for buffer overflow.
-    if (this->bytes_read_ >= this->max_telegram_len_) {
-      this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: telegram larger than buffer (%d bytes)", this->max_telegram_len_);
-      return;
+bool Dsmr::process_telegram_byte_(char c) {
+  // Find a new telegram header, i.e. forward slash.
+  if (c == '/') {
+    ESP_LOGV(TAG, "Header of telegram found");
+    this->start_telegram_();
+  }
+  if (!this->header_found_)
+    return false;
+
+  // Check for the maximum telegram size.
+  if (++this->bytes_read_ > this->max_telegram_len_) {
+    this->header_found_ = false;
+    ESP_LOGE(TAG, "Error: telegram larger than maximum telegram length (%d bytes)", this->max_telegram_len_);
+    return false;
+  }
+
+  // Collect the hex checksum after the footer until the end of the line.
+  if (this->footer_found_) {
+    if (c == '\n') {
+      this->finish_telegram_();
+      this->header_found_ = false;
+      return true;
     }
+    if (c != '\r' && this->crc_len_ < sizeof(this->crc_str_))
+      this->crc_str_[this->crc_len_++] = c;
+    return false;
+  }
+
+  // The checksum covers everything from the header up to and including the footer.
+  this->crc_ = crc16_update(this->crc_, c);
+  if (c == '/')
+    return false;
 
+  // Check for a footer, i.e. exclamation mark, followed by a hex checksum.
+  if (c == '!') {
+    ESP_LOGV(TAG, "Footer of telegram found");
+    this->parse_line_();
+    this->footer_found_ = true;
+    return false;
+  }
+
+  if (c == '\r' || c == '\n') {
+    this->line_complete_ = true;
+    return false;
+  }
+  if (this->line_complete_) {
     // Some v2.2 or v3 meters will send a new value which starts with '('
-    // in a new line, while the value belongs to the previous ObisId. For
-    // proper parsing, remove these new line characters.
-    if (c == '(') {
-      while (true) {
-        auto previous_char = this->telegram_[this->bytes_read_ - 1];
-        if (previous_char == '\n' || previous_char == '\r') {
-          this->bytes_read_--;
-        } else {
-          break;
-        }
-      }
-    }
+    // in a new line, while the value belongs to the previous ObisId. So
+    // a line is only parsed once the next one turns out not to continue it.
+    if (c != '(')
+      this->parse_line_();
+    this->line_complete_ = false;
+  }
 
-    // Store the byte in the buffer.
-    this->telegram_[this->bytes_read_] = c;
-    this->bytes_read_++;
+  if (this->line_len_ < this->max_line_len_) {
+    this->line_[this->line_len_++] = c;
+  } else {
+    this->line_overflow_ = true;
+  }
+  return false;
+}
+
+void Dsmr::parse_line_() {
+  if (this->line_overflow_) {
+    // Only lines of sensors that aren't configured can be longer than the line buffer
+    ESP_LOGV(TAG, "Skipping line longer than %u bytes", this->max_line_len_);
+  } else if (this->line_len_ != 0 && !this->telegram_error_) {
+    const char *end = this->line_ + this->line_len_;
+    ::dsmr::ParseResult<void> res;
+    if (this->first_line_) {
+      // The identification line is offered using the all-ones ObisId, which is not otherwise valid.
+      res = this->data_.parse_line(::dsmr::ObisId(255, 255, 255, 255, 255, 255), this->line_, end);
+    } else {
+      // Ignore unknown values.
+      res = ::dsmr::P1Parser::parse_line(&this->data_, this->line_, end, false);
+    }
+    if (res.err) {
+      // Parsing error, show it
+      auto err_str = res.fullError(this->line_, end);
+      ESP_LOGE(TAG, "%s", err_str.c_str());
+      this->telegram_error_ = true;
+    }
+  }
+  this->line_len_ = 0;
+  this->line_complete_ = false;
+  this->line_overflow_ = false;
+  this->first_line_ = false;
+}
 
-    // Check for a footer, i.e. exlamation mark, followed by a hex checksum.
-    if (c == '!') {
-      ESP_LOGV(TAG, "Footer of telegram found");
-      this->footer_found_ = true;
-      continue;
+void Dsmr::finish_telegram_() {
+  ESP_LOGV(TAG, "End of telegram found");
+  this->stop_requesting_data_();
+  if (this->crc_check_) {
+    char crc_str[sizeof(this->crc_str_) + 1] = {0};
+    memcpy(crc_str, this->crc_str_, this->crc_len_);
+    char *end;
+    auto crc = static_cast<uint16_t>(strtoul(crc_str, &end, 16));
+    if (this->crc_len_ != sizeof(this->crc_str_) || *end != '\0') {
+      ESP_LOGE(TAG, "No checksum found");
+      return;
     }
-    // Check for the end of the hex checksum, i.e. a newline.
-    if (this->footer_found_ && c == '\n') {
-      // Parse the telegram and publish sensor values.
-      this->parse_telegram();
-      this->reset_telegram_();
+    if (crc != this->crc_) {
+      ESP_LOGE(TAG, "Checksum mismatch, calculated %04X but telegram says %s", this->crc_, crc_str);
       return;
     }
   }
+  if (this->telegram_error_)
+    return;
+  this->status_clear_warning();
+  this->publish_sensors(this->data_);
 }
 
 void Dsmr::receive_encrypted_telegram_() {
+  uint8_t buf[CHUNK_SIZE];
   while (this->available_within_timeout_()) {
-    const char c = this->read();
-
-    // Find a new telegram start byte.
-    if (!this->header_found_) {
-      if ((uint8_t) c != 0xDB) {
+    size_t len = this->read_available(buf, sizeof(buf));
+    size_t i = 0;
+    while (i < len) {
+      // Find a new telegram start byte.
+      if (this->crypt_bytes_read_ == 0) {
+        if (buf[i++] != 0xDB)
+          continue;
+        ESP_LOGV(TAG, "Start byte 0xDB of encrypted telegram found");
+        this->reset_telegram_();
+        this->crypt_header_[0] = 0xDB;
+        this->crypt_bytes_read_ = 1;
         continue;
       }
-      ESP_LOGV(TAG, "Start byte 0xDB of encrypted telegram found");
-      this->reset_telegram_();
-      this->header_found_ = true;
-    }
-
-    // Check for buffer overflow.
-    if (this->crypt_bytes_read_ >= this->max_telegram_len_) {
-      this->reset_telegram_();
-      ESP_LOGE(TAG, "Error: encrypted telegram larger than buffer (%d bytes)", this->max_telegram_len_);
-      return;
-    }
-
-    // Store the byte in the buffer.
-    this->crypt_telegram_[this->crypt_bytes_read_] = c;
-    this->crypt_bytes_read_++;
 
-    // Read the length of the incoming encrypted telegram.
-    if (this->crypt_telegram_len_ == 0 && this->crypt_bytes_read_ > 20) {
-      // Complete header + data bytes
-      this->crypt_telegram_len_ = 13 + (this->crypt_telegram_[11] << 8 | this->crypt_telegram_[12]);
-      ESP_LOGV(TAG, "Encrypted telegram length: %d bytes", this->crypt_telegram_len_);
-    }
+      // Collect the header.
+      if (this->crypt_bytes_read_ < sizeof(this->crypt_header_)) {
+        this->crypt_header_[this->crypt_bytes_read_++] = buf[i++];
+        if (this->crypt_bytes_read_ == sizeof(this->crypt_header_) && !this->start_decryption_()) {
+          this->reset_telegram_();
+          return;
+        }
+        continue;
+      }
 
-    // Check for the end of the encrypted telegram.
-    if (this->crypt_telegram_len_ == 0 || this->crypt_bytes_read_ != this->crypt_telegram_len_) {
-      continue;
+      // Decrypt the ciphertext in place and parse it, the authentication tag at the end is skipped.
+      size_t chunk = std::min(len - i, this->crypt_telegram_len_ - this->crypt_bytes_read_);
+      size_t ciphertext_end = this->crypt_telegram_len_ - CRYPT_TAG_SIZE;
+      size_t ciphertext = this->crypt_bytes_read_ < ciphertext_end
+                              ? std::min(chunk, ciphertext_end - this->crypt_bytes_read_)
+                              : 0;
+      this->gcm_->decrypt(&buf[i], &buf[i], ciphertext);
+      for (size_t j = 0; j < ciphertext; j++) {
+        if (this->process_telegram_byte_(buf[i + j])) {
+          // The rest of the frame was discarded when the telegram was complete
+          this->reset_telegram_();
+          return;
+        }
+      }
+      this->crypt_bytes_read_ += chunk;
+      i += chunk;
+
+      // Check for the end of the encrypted telegram.
+      if (this->crypt_bytes_read_ == this->crypt_telegram_len_) {
+        ESP_LOGV(TAG, "End of encrypted telegram found");
+        this->stop_requesting_data_();
+        this->reset_telegram_();
+        return;
+      }
     }
-    ESP_LOGV(TAG, "End of encrypted telegram found");
-
-    // Decrypt the encrypted telegram.
-    GCM<AES128> *gcmaes128{new GCM<AES128>()};
-    gcmaes128->setKey(this->decryption_key_.data(), gcmaes128->keySize());
-    // the iv is 8 bytes of the system title + 4 bytes frame counter
-    // system title is at byte 2 and frame counter at byte 15
-    for (int i = 10; i < 14; i++)
-      this->crypt_telegram_[i] = this->crypt_telegram_[i + 4];
-    constexpr uint16_t iv_size{12};
-    gcmaes128->setIV(&this->crypt_telegram_[2], iv_size);
-    gcmaes128->decrypt(reinterpret_cast<uint8_t *>(this->telegram_),
-                       // the ciphertext start at byte 18
-                       &this->crypt_telegram_[18],
-                       // cipher size
-                       this->crypt_bytes_read_ - 17);
-    delete gcmaes128;  // NOLINT(cppcoreguidelines-owning-memory)
-
-    this->bytes_read_ = strnlen(this->telegram_, this->max_telegram_len_);
-    ESP_LOGV(TAG, "Decrypted telegram size: %d bytes", this->bytes_read_);
-    ESP_LOGVV(TAG, "Decrypted telegram: %s", this->telegram_);
-
-    // Parse the decrypted telegram and publish sensor values.
-    this->parse_telegram();
-    this->reset_telegram_();
-    return;
   }
 }
 
-bool Dsmr::parse_telegram() {
-  MyData data;
-  ESP_LOGV(TAG, "Trying to parse telegram");
-  this->stop_requesting_data_();
-  ::dsmr::ParseResult<void> res =
-      ::dsmr::P1Parser::parse(&data, this->telegram_, this->bytes_read_, false,
-                              this->crc_check_);  // Parse telegram according to data definition. Ignore unknown values.
-  if (res.err) {
-    // Parsing error, show it
-    auto err_str = res.fullError(this->telegram_, this->telegram_ + this->bytes_read_);
-    ESP_LOGE(TAG, "%s", err_str.c_str());
+bool Dsmr::start_decryption_() {
+  // Complete header + data bytes
+  this->crypt_telegram_len_ = 13 + (this->crypt_header_[11] << 8 | this->crypt_header_[12]);
+  ESP_LOGV(TAG, "Encrypted telegram length: %d bytes", this->crypt_telegram_len_);
+  if (this->crypt_telegram_len_ > this->max_telegram_len_) {
+    ESP_LOGE(TAG, "Error: encrypted telegram larger than maximum telegram length (%d bytes)", this->max_telegram_len_);
     return false;
-  } else {
-    this->status_clear_warning();
-    this->publish_sensors(data);
-    return true;
   }
+  if (this->crypt_telegram_len_ < sizeof(this->crypt_header_) + CRYPT_TAG_SIZE) {
+    ESP_LOGE(TAG, "Error: invalid encrypted telegram length");
+    return false;
+  }
+
+  this->gcm_->setKey(this->decryption_key_.data(), this->gcm_->keySize());
+  // the iv is 8 bytes of the system title + 4 bytes frame counter
+  // system title is at byte 2 and frame counter at byte 14
+  uint8_t iv[12];
+  memcpy(iv, &this->crypt_header_[2], 8);
+  memcpy(iv + 8, &this->crypt_header_[14], 4);
+  this->gcm_->setIV(iv, sizeof(iv));
+  return true;
 }
 
 void Dsmr::dump_config() {
   ESP_LOGCONFIG(TAG, "DSMR:");
   ESP_LOGCONFIG(TAG, "  Max telegram length: %d", this->max_telegram_len_);
+  ESP_LOGCONFIG(TAG, "  Max line length: %d", this->max_line_len_);
   ESP_LOGCONFIG(TAG, "  Receive timeout: %.1fs", this->receive_timeout_ / 1e3f);
   if (this->request_pin_ != nullptr) {
     LOG_PIN("  Request Pin: ", this->request_pin_);
@@ -293,10 +390,7 @@ void Dsmr::set_decryption_key(const std::string &decryption_key) {
   if (decryption_key.length() == 0) {
     ESP_LOGI(TAG, "Disabling decryption");
     this->decryption_key_.clear();
-    if (this->crypt_telegram_ != nullptr) {
-      delete[] this->crypt_telegram_;
-      this->crypt_telegram_ = nullptr;
-    }
+    this->gcm_.reset();
     return;
   }
 
@@ -316,8 +410,8 @@ void Dsmr::set_decryption_key(const std::string &decryption_key) {
     this->decryption_key_.push_back(std::strtoul(temp, nullptr, 16));
   }
 
-  if (this->crypt_telegram_ == nullptr) {
-    this->crypt_telegram_ = new uint8_t[this->max_telegram_len_];  // NOLINT
+  if (this->gcm_ == nullptr) {
+    this->gcm_ = make_unique<GCM<AES128>>();
   }
 }
 
@@ -13,6 +13,10 @@
 #include <dsmr/parser.h>
 #include <dsmr/fields.h>
 
+#include <AES.h>
+#include <GCM.h>
+#include <memory>
+
 namespace esphome {
 namespace dsmr {
 
@@ -45,6 +49,13 @@ using namespace ::dsmr::fields;
 using MyData = ::dsmr::ParsedData<DSMR_TEXT_SENSOR_LIST(DSMR_DATA_SENSOR, DSMR_COMMA)
                                       DSMR_BOTH DSMR_SENSOR_LIST(DSMR_DATA_SENSOR, DSMR_COMMA)>;
 
+/** Reads telegrams from a P1 port.
+ *
+ * Telegrams aren't buffered as a whole. Each line is parsed into the staged sensor values as soon as it's complete
+ * and the CRC is updated with every byte, so only the longest line needs to fit in a buffer. The staged values are
+ * published together once the CRC at the end of the telegram turns out to be valid. Encrypted telegrams are decrypted
+ * in chunks while they're received.
+ */
 class Dsmr : public Component, public uart::UARTDevice {
  public:
   Dsmr(uart::UARTComponent *uart, bool crc_check) : uart::UARTDevice(uart), crc_check_(crc_check) {}
@@ -52,8 +63,6 @@ class Dsmr : public Component, public uart::UARTDevice {
   void setup() override;
   void loop() override;
 
-  bool parse_telegram();
-
   void publish_sensors(MyData &data) {
 #define DSMR_PUBLISH_SENSOR(s) \
   if (data.s##_present && this->s_##s##_ != nullptr) \
@@ -70,6 +79,8 @@ class Dsmr : public Component, public uart::UARTDevice {
 
   void set_decryption_key(const std::string &decryption_key);
   void set_max_telegram_length(size_t length) { this->max_telegram_len_ = length; }
+  /// Set the length of the line buffer, longer lines are skipped.
+  void set_max_line_length(size_t length) { this->max_line_len_ = length; }
   void set_request_pin(GPIOPin *request_pin) { this->request_pin_ = request_pin; }
   void set_request_interval(uint32_t interval) { this->request_interval_ = interval; }
   void set_receive_timeout(uint32_t timeout) { this->receive_timeout_ = timeout; }
@@ -86,7 +97,18 @@ class Dsmr : public Component, public uart::UARTDevice {
  protected:
   void receive_telegram_();
   void receive_encrypted_telegram_();
+  /// Stop reading the current telegram, plaintext or encrypted.
   void reset_telegram_();
+  /// Start parsing a plaintext telegram at its header.
+  void start_telegram_();
+  /// Process a byte of a plaintext telegram, returns true when the end of the telegram was reached.
+  bool process_telegram_byte_(char c);
+  /// Parse the line in the line buffer into the staged sensor values.
+  void parse_line_();
+  /// Check the CRC and publish the staged sensor values.
+  void finish_telegram_();
+  /// Set up decryption after the header of an encrypted telegram, returns false if the header is invalid.
+  bool start_decryption_();
 
   /// Wait for UART data to become available within the read timeout.
   ///
@@ -113,15 +135,32 @@ class Dsmr : public Component, public uart::UARTDevice {
   uint32_t receive_timeout_;
   bool receive_timeout_reached_();
   size_t max_telegram_len_;
-  char *telegram_{nullptr};
   size_t bytes_read_{0};
-  uint8_t *crypt_telegram_{nullptr};
-  size_t crypt_telegram_len_{0};
-  size_t crypt_bytes_read_{0};
   uint32_t last_read_time_{0};
   bool header_found_{false};
   bool footer_found_{false};
 
+  // Parse telegram
+  MyData data_;
+  char *line_{nullptr};
+  size_t max_line_len_{128};
+  size_t line_len_{0};
+  /// The line ended, but the next one may still continue it.
+  bool line_complete_{false};
+  bool line_overflow_{false};
+  bool first_line_{true};
+  bool telegram_error_{false};
+  uint16_t crc_{0};
+  char crc_str_[4];
+  uint8_t crc_len_{0};
+
+  // Decrypt telegram
+  std::unique_ptr<GCM<AES128>> gcm_;
+  /// Start byte, system title, length, security control byte and frame counter.
+  uint8_t crypt_header_[18];
+  size_t crypt_telegram_len_{0};
+  size_t crypt_bytes_read_{0};
+
 // Sensor member pointers
 #define DSMR_DECLARE_SENSOR(s) sensor::Sensor *s_##s##_{nullptr};
   DSMR_SENSOR_LIST(DSMR_DECLARE_SENSOR, )
@@ -6,6 +6,13 @@ from . import Dsmr, CONF_DSMR_ID
 
 AUTO_LOAD = ["dsmr"]
 
+# Lines of these fields can be longer than the default line buffer of the parser
+MAX_LINE_LENGTHS = {
+    "electricity_failure_log": 512,
+    "message_long": 2064,
+    "gas_delivered_text": 256,
+}
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(CONF_DSMR_ID): cv.use_id(Dsmr),
@@ -39,6 +46,10 @@ async def to_code(config):
             cg.add(getattr(hub, f"set_{key}")(var))
             text_sensors.append(f"F({key})")
 
+    line_lengths = [MAX_LINE_LENGTHS[key] for key in config if key in MAX_LINE_LENGTHS]
+    if line_lengths:
+        cg.add(hub.set_max_line_length(max(line_lengths)))
+
     if text_sensors:
         cg.add_define(
             "DSMR_TEXT_SENSOR_LIST(F, sep)",
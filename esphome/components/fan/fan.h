@@ -5,6 +5,7 @@
 #include "esphome/core/log.h"
 #include "esphome/core/optional.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/state_journal.h"
 #include "fan_traits.h"
 
 namespace esphome {
@@ -146,7 +147,7 @@ class Fan : public EntityBase {
   uint32_t hash_base() override;
 
   CallbackManager<void()> state_callback_{};
-  ESPPreferenceObject rtc_;
+  StateJournalRecord rtc_;
   FanRestoreMode restore_mode_;
 };
 
@@ -17,15 +17,32 @@ GlobalsComponent = globals_ns.class_("GlobalsComponent", cg.Component)
 RestoringGlobalsComponent = globals_ns.class_("RestoringGlobalsComponent", cg.Component)
 GlobalVarSetAction = globals_ns.class_("GlobalVarSetAction", automation.Action)
 
+CONF_MIN_SAVE_INTERVAL = "min_save_interval"
+CONF_DETECT_CHANGES = "detect_changes"
+
+
+def validate_restore_options(config):
+    if not config[CONF_RESTORE_VALUE]:
+        for key in (CONF_MIN_SAVE_INTERVAL, CONF_DETECT_CHANGES):
+            if key in config:
+                raise cv.Invalid(f"{key} requires restore_value to be enabled")
+    return config
+
+
 MULTI_CONF = True
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.Required(CONF_ID): cv.declare_id(GlobalsComponent),
-        cv.Required(CONF_TYPE): cv.string_strict,
-        cv.Optional(CONF_INITIAL_VALUE): cv.string_strict,
-        cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
-    }
-).extend(cv.COMPONENT_SCHEMA)
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_ID): cv.declare_id(GlobalsComponent),
+            cv.Required(CONF_TYPE): cv.string_strict,
+            cv.Optional(CONF_INITIAL_VALUE): cv.string_strict,
+            cv.Optional(CONF_RESTORE_VALUE, default=False): cv.boolean,
+            cv.Optional(CONF_MIN_SAVE_INTERVAL): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_DETECT_CHANGES): cv.boolean,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_restore_options,
+)
 
 
 # Run with low priority so that namespaces are registered first
@@ -52,6 +69,10 @@ async def to_code(config):
             value = value.encode()
         hash_ = int(hashlib.md5(value).hexdigest()[:8], 16)
         cg.add(glob.set_name_hash(hash_))
+        if CONF_MIN_SAVE_INTERVAL in config:
+            cg.add(glob.set_min_save_interval(config[CONF_MIN_SAVE_INTERVAL]))
+        if CONF_DETECT_CHANGES in config:
+            cg.add(glob.set_detect_changes(config[CONF_DETECT_CHANGES]))
 
 
 @automation.register_action(
@@ -3,7 +3,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
+#include "esphome/core/hal.h"
 #include <cstring>
+#include <memory>
 
 namespace esphome {
 namespace globals {
@@ -18,6 +20,8 @@ template<typename T> class GlobalsComponent : public Component {
   }
 
   T &value() { return this->value_; }
+  /// Does nothing, the value isn't saved.
+  void mark_dirty() {}
   void setup() override {}
 
  protected:
@@ -36,28 +40,75 @@ template<typename T> class RestoringGlobalsComponent : public Component {
 
   T &value() { return this->value_; }
 
+  /** Save the value after it was changed through value().
+   *
+   * Saves are delayed to at most one per minimum save interval. Without change detection, this has to be called after
+   * every change made from a lambda.
+   */
+  void mark_dirty() {
+    if (this->save_pending_)
+      return;
+    this->save_pending_ = true;
+    uint32_t since_save = millis() - this->last_save_;
+    uint32_t delay = since_save >= this->min_save_interval_ ? 0 : this->min_save_interval_ - since_save;
+    this->set_timeout("save", delay, [this]() { this->save_(); });
+  }
+
   void setup() override {
     this->rtc_ = global_preferences->make_preference<T>(1944399030U ^ this->name_hash_);
     this->rtc_.load(&this->value_);
-    memcpy(&this->prev_value_, &this->value_, sizeof(T));
+    if (this->detect_changes_) {
+      // Compare with a copy of the saved value, but only once per save interval instead of every loop
+      this->prev_value_.reset(new uint8_t[sizeof(T)]);  // NOLINT(cppcoreguidelines-owning-memory)
+      memcpy(this->prev_value_.get(), &this->value_, sizeof(T));
+      this->set_interval("detect_changes", this->min_save_interval_, [this]() {
+        if (memcmp(&this->value_, this->prev_value_.get(), sizeof(T)) != 0)
+          this->mark_dirty();
+      });
+    }
   }
 
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
-  void loop() override {
-    int diff = memcmp(&this->value_, &this->prev_value_, sizeof(T));
-    if (diff != 0) {
-      this->rtc_.save(&this->value_);
-      memcpy(&this->prev_value_, &this->value_, sizeof(T));
-    }
+  void on_safe_shutdown() override { this->save_unsaved_(); }
+  void on_shutdown() override {
+    // The preferences may already have been synced for this shutdown, so write this save out too
+    if (this->save_unsaved_())
+      global_preferences->sync();
   }
 
   void set_name_hash(uint32_t name_hash) { this->name_hash_ = name_hash; }
+  /// Set the minimum time in milliseconds between two saves of the value.
+  void set_min_save_interval(uint32_t min_save_interval) { this->min_save_interval_ = min_save_interval; }
+  /// Set whether to keep a copy of the value to detect changes, otherwise changes must be marked with mark_dirty().
+  void set_detect_changes(bool detect_changes) { this->detect_changes_ = detect_changes; }
 
  protected:
+  void save_() {
+    this->save_pending_ = false;
+    this->last_save_ = millis();
+    this->rtc_.save(&this->value_);
+    if (this->prev_value_)
+      memcpy(this->prev_value_.get(), &this->value_, sizeof(T));
+  }
+  /// Save right away if a save is pending or the value changed since the last one, returns whether it saved.
+  bool save_unsaved_() {
+    if (!this->save_pending_ &&
+        (!this->prev_value_ || memcmp(&this->value_, this->prev_value_.get(), sizeof(T)) == 0))
+      return false;
+    this->cancel_timeout("save");
+    this->save_();
+    return true;
+  }
+
   T value_{};
-  T prev_value_{};
+  /// The last saved value, only allocated when detecting changes.
+  std::unique_ptr<uint8_t[]> prev_value_;
   uint32_t name_hash_{};
+  uint32_t min_save_interval_{1000};
+  uint32_t last_save_{0};
+  bool detect_changes_{true};
+  bool save_pending_{false};
   ESPPreferenceObject rtc_;
 };
 
@@ -69,7 +120,10 @@ template<class C, typename... Ts> class GlobalVarSetAction : public Action<Ts...
 
   TEMPLATABLE_VALUE(T, value);
 
-  void play(Ts... x) override { this->parent_->value() = this->value_.value(x...); }
+  void play(Ts... x) override {
+    this->parent_->value() = this->value_.value(x...);
+    this->parent_->mark_dirty();
+  }
 
  protected:
   C *parent_;
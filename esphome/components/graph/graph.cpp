@@ -15,9 +15,30 @@ using namespace display;
 static const char *const TAG = "graph";
 static const char *const TAGL = "graphlegend";
 
+void SlidingExtreme::push(uint32_t seq, float value) {
+  // Values that can't become the extreme anymore, because this newer one is at least as extreme, are dropped
+  while (this->size_ != 0) {
+    const Entry &last = this->entries_[(this->head_ + this->size_ - 1) % this->entries_.size()];
+    if (this->max_ ? last.value > value : last.value < value)
+      break;
+    this->size_--;
+  }
+  this->entries_[(this->head_ + this->size_) % this->entries_.size()] = Entry{seq, value};
+  this->size_++;
+}
+
+void SlidingExtreme::expire(uint32_t oldest_seq) {
+  while (this->size_ != 0 && int32_t(this->entries_[this->head_].seq - oldest_seq) < 0) {
+    this->head_ = (this->head_ + 1) % this->entries_.size();
+    this->size_--;
+  }
+}
+
 void HistoryData::init(int length) {
   this->length_ = length;
-  this->samples_.resize(length, NAN);
+  this->samples_.resize(length, Entry{NAN, NAN, NAN});
+  this->recent_min_.init(length);
+  this->recent_max_.init(length);
   this->last_sample_ = millis();
 }
 
@@ -26,29 +47,56 @@ void HistoryData::take_sample(float data) {
   uint32_t dt = tm - last_sample_;
   last_sample_ = tm;
 
+  if (!std::isnan(data)) {
+    this->current_min_ = std::isnan(this->current_min_) ? data : std::min(this->current_min_, data);
+    this->current_max_ = std::isnan(this->current_max_) ? data : std::max(this->current_max_, data);
+  }
+
   // Step data based on time
   this->period_ += dt;
+  bool pushed = false;
   while (this->period_ >= this->update_time_) {
-    this->samples_[this->count_] = data;
+    this->push_(data, this->current_min_, this->current_max_);
+    // Further entries fill the gap since the last sample
+    this->current_min_ = data;
+    this->current_max_ = data;
     this->period_ -= this->update_time_;
-    this->count_ = (this->count_ + 1) % this->length_;
+    pushed = true;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
-  if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
-    for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
-    }
+  if (pushed) {
+    this->current_min_ = NAN;
+    this->current_max_ = NAN;
   }
 }
 
+void HistoryData::push_(float value, float min, float max) {
+  this->samples_[this->count_] = Entry{value, min, max};
+  this->count_ = (this->count_ + 1) % this->length_;
+
+  uint32_t seq = this->pushed_++;
+  this->recent_min_.expire(seq - this->length_ + 1);
+  this->recent_max_.expire(seq - this->length_ + 1);
+  if (!std::isnan(min))
+    this->recent_min_.push(seq, min);
+  if (!std::isnan(max))
+    this->recent_max_.push(seq, max);
+}
+
+float HistoryData::get_recent_max() const {
+  float mx = this->recent_max_.get();
+  if (std::isnan(mx) || this->current_max_ > mx)
+    return this->current_max_;
+  return mx;
+}
+
+float HistoryData::get_recent_min() const {
+  float mn = this->recent_min_.get();
+  if (std::isnan(mn) || this->current_min_ < mn)
+    return this->current_min_;
+  return mn;
+}
+
 void GraphTrace::init(Graph *g) {
   ESP_LOGI(TAG, "Init trace for sensor %s", this->get_name().c_str());
   this->data_.init(g->get_width());
@@ -158,16 +206,18 @@ void Graph::draw(DisplayBuffer *buff, uint16_t x_offset, uint16_t y_offset, Colo
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     uint16_t thick = trace->get_line_thickness();
+    const HistoryData *data = trace->get_tracedata();
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
+      // Draw a span covering all samples of this pixel, so peaks stay visible
+      float vmax = (data->get_max(i) - ymin) / yrange;
+      float vmin = (data->get_min(i) - ymin) / yrange;
+      if (!std::isnan(vmax) && !std::isnan(vmin) && (thick > 0)) {
         int16_t x = this->width_ - 1 - i;
         uint8_t b = (i % (thick * LineType::PATTERN_LENGTH)) / thick;
         if (((uint8_t) trace->get_line_type() & (1 << b)) == (1 << b)) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2;
-          for (uint16_t t = 0; t < thick; t++) {
-            buff->draw_pixel_at(x_offset + x, y_offset + y + t, c);
-          }
+          int16_t ytop = (int16_t) roundf((this->height_ - 1) * (1.0 - vmax)) - thick / 2;
+          int16_t ybottom = (int16_t) roundf((this->height_ - 1) * (1.0 - vmin)) - thick / 2;
+          buff->vertical_line(x_offset + x, y_offset + ytop, ybottom - ytop + thick, c);
         }
       }
     }
@@ -82,26 +82,71 @@ class GraphLegend {
   friend Graph;
 };
 
+/// Tracks the minimum or maximum of the values in a sliding window, in amortized constant time per value.
+class SlidingExtreme {
+ public:
+  explicit SlidingExtreme(bool max) : max_(max) {}
+  void init(int length) { this->entries_.resize(length); }
+  /// Add a value, seq increments by one for every position of the window.
+  void push(uint32_t seq, float value);
+  /// Drop the values before oldest_seq from the window.
+  void expire(uint32_t oldest_seq);
+  /// The extreme of the values in the window, NAN if there are none.
+  float get() const { return this->size_ == 0 ? NAN : this->entries_[this->head_].value; }
+
+ protected:
+  struct Entry {
+    uint32_t seq;
+    float value;
+  };
+
+  /// The entries form a ring of monotonic values, ordered from the extreme to the most recent value.
+  std::vector<Entry> entries_;
+  size_t head_{0};
+  size_t size_{0};
+  bool max_;
+};
+
+/** The history of a trace, one entry per pixel.
+ *
+ * Each entry keeps the minimum and maximum of all samples taken during its time span next to the last one, so peaks
+ * aren't lost when a graph covers a long duration.
+ */
 class HistoryData {
  public:
   void init(int length);
-  ~HistoryData();
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
-  float get_recent_max() const { return recent_max_; }
-  float get_recent_min() const { return recent_min_; }
+  float get_value(int idx) const { return this->get_entry_(idx).value; }
+  float get_min(int idx) const { return this->get_entry_(idx).min; }
+  float get_max(int idx) const { return this->get_entry_(idx).max; }
+  float get_recent_max() const;
+  float get_recent_min() const;
 
  protected:
+  struct Entry {
+    float value;
+    float min;
+    float max;
+  };
+
+  const Entry &get_entry_(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
+  void push_(float value, float min, float max);
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
   int length_;
   int count_{0};
-  float recent_min_{NAN};
-  float recent_max_{NAN};
-  std::vector<float> samples_;
+  /// Number of entries pushed so far, the sequence number of the window extremes.
+  uint32_t pushed_{0};
+  /// Extremes of the samples taken since the last entry was pushed.
+  float current_min_{NAN};
+  float current_max_{NAN};
+  SlidingExtreme recent_min_{false};
+  SlidingExtreme recent_max_{true};
+  std::vector<Entry> samples_;
 };
 
 class GraphTrace {
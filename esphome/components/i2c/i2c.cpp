@@ -1,5 +1,6 @@
 #include "i2c.h"
 #include "esphome/core/log.h"
+#include "esphome/core/hal.h"
 #include <memory>
 
 namespace esphome {
@@ -7,6 +8,8 @@ namespace i2c {
 
 static const char *const TAG = "i2c";
 
+I2CTransaction I2CDevice::transaction(uint32_t delay) { return I2CTransaction(this->address_, millis() + delay); }
+
 bool I2CDevice::write_bytes_16(uint8_t a_register, const uint16_t *data, uint8_t len) {
   // we have to copy in order to be able to change byte order
   std::unique_ptr<uint16_t[]> temp{new uint16_t[len]};
@@ -45,6 +45,13 @@ class I2CDevice {
 
   I2CRegister reg(uint8_t a_register) { return {this, a_register}; }
 
+  /// Create a transaction on this device that should run delay milliseconds from now.
+  I2CTransaction transaction(uint32_t delay = 0);
+  /// Queue a transaction on the bus, see I2CBus::submit().
+  void submit(I2CTransaction &&transaction, std::function<void(ErrorCode)> &&callback) {
+    bus_->submit(std::move(transaction), std::move(callback));
+  }
+
   ErrorCode read(uint8_t *data, size_t len) { return bus_->read(address_, data, len); }
   ErrorCode read_register(uint8_t a_register, uint8_t *data, size_t len) {
     ErrorCode err = this->write(&a_register, 1);
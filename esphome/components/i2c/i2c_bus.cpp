@@ -0,0 +1,125 @@
+#include "i2c_bus.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+#include <iterator>
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c";
+
+/// The interval in milliseconds at which the transaction statistics are logged.
+static const uint32_t STATS_INTERVAL = 60000;
+
+I2CTransaction &I2CTransaction::write(const uint8_t *data, size_t len) {
+  this->operations_.push_back(Operation{nullptr, this->write_data_.size(), len});
+  this->write_data_.insert(this->write_data_.end(), data, data + len);
+  return *this;
+}
+
+I2CTransaction &I2CTransaction::read(uint8_t *data, size_t len) {
+  this->operations_.push_back(Operation{data, 0, len});
+  return *this;
+}
+
+I2CTransaction &I2CTransaction::write_register(uint8_t a_register, const uint8_t *data, size_t len) {
+  // Both end up in a single write
+  this->write(&a_register, 1);
+  return this->write(data, len);
+}
+
+I2CTransaction &I2CTransaction::read_register(uint8_t a_register, uint8_t *data, size_t len) {
+  this->write(&a_register, 1);
+  return this->read(data, len);
+}
+
+void I2CBus::submit(I2CTransaction &&transaction, std::function<void(ErrorCode)> &&callback) {
+  transaction.callback_ = std::move(callback);
+  uint32_t deadline = transaction.deadline_;
+  // Keep the order of transactions with the same deadline
+  auto it = std::find_if(this->transactions_.begin(), this->transactions_.end(), [deadline](const I2CTransaction &t) {
+    return int32_t(t.deadline_ - deadline) > 0;
+  });
+  this->transactions_.insert(it, std::move(transaction));
+}
+
+float I2CBus::get_utilisation() const {
+  uint32_t elapsed = millis() - this->stats_start_;
+  if (elapsed == 0)
+    return 0.0f;
+  return std::min(1.0f, this->busy_time_ / (elapsed * 1000.0f));
+}
+
+void I2CBus::process_transactions_() {
+  uint32_t now = millis();
+  size_t due = 0;
+  while (due < this->transactions_.size() && int32_t(now - this->transactions_[due].deadline_) >= 0)
+    due++;
+
+  if (due != 0) {
+    // Callbacks may submit new transactions, so take the due ones out of the queue first
+    std::vector<I2CTransaction> running;
+    running.reserve(due);
+    std::move(this->transactions_.begin(), this->transactions_.begin() + due, std::back_inserter(running));
+    this->transactions_.erase(this->transactions_.begin(), this->transactions_.begin() + due);
+
+    for (auto &transaction : running) {
+      uint32_t latency = millis() - transaction.deadline_;
+      uint32_t start = micros();
+      ErrorCode err = this->run_transaction_(transaction);
+      this->busy_time_ += micros() - start;
+
+      auto stats = std::find_if(this->device_stats_.begin(), this->device_stats_.end(),
+                                [&transaction](const DeviceStats &s) { return s.address == transaction.address_; });
+      if (stats == this->device_stats_.end()) {
+        this->device_stats_.push_back(DeviceStats{transaction.address_, 0, 0, 0});
+        stats = this->device_stats_.end() - 1;
+      }
+      stats->count++;
+      stats->latency_total += latency;
+      stats->latency_max = std::max(stats->latency_max, latency);
+
+      if (transaction.callback_)
+        transaction.callback_(err);
+    }
+  }
+
+  if (millis() - this->stats_start_ < STATS_INTERVAL)
+    return;
+  if (!this->device_stats_.empty()) {
+    ESP_LOGV(TAG, "Bus utilisation %.1f%% over the last %us", this->get_utilisation() * 100.0f,
+             (millis() - this->stats_start_) / 1000);
+    for (auto &stats : this->device_stats_) {
+      ESP_LOGV(TAG, "  0x%02X: %u transactions, latency average %ums, maximum %ums", stats.address, stats.count,
+               stats.latency_total / stats.count, stats.latency_max);
+    }
+  }
+  this->device_stats_.clear();
+  this->busy_time_ = 0;
+  this->stats_start_ = millis();
+}
+
+ErrorCode I2CBus::run_transaction_(I2CTransaction &transaction) {
+  std::vector<WriteBuffer> writes;
+  auto &operations = transaction.operations_;
+  for (size_t i = 0; i < operations.size(); i++) {
+    auto &operation = operations[i];
+    ErrorCode err;
+    if (operation.read_data != nullptr) {
+      err = this->read(transaction.address_, operation.read_data, operation.len);
+    } else {
+      writes.push_back(WriteBuffer{transaction.write_data_.data() + operation.offset, operation.len});
+      if (i + 1 < operations.size() && operations[i + 1].read_data == nullptr)
+        continue;
+      err = this->writev(transaction.address_, writes.data(), writes.size());
+      writes.clear();
+    }
+    if (err != ERROR_OK)
+      return err;
+  }
+  return ERROR_OK;
+}
+
+}  // namespace i2c
+}  // namespace esphome
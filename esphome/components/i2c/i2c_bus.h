@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,52 @@ struct WriteBuffer {
   size_t len;
 };
 
+class I2CBus;
+
+/** A list of reads and writes on one device, queued with I2CBus::submit() to run once it is due.
+ *
+ * Data to write is copied into the transaction, reads go to buffers owned by the caller that must stay valid until the
+ * transaction's callback is called. Consecutive writes are combined into a single write on the bus.
+ *
+ * @code
+ * i2c::I2CTransaction transaction(this->address_, millis() + 50);
+ * transaction.read_register(0xF7, this->data_, 8).read_register(0xE1, this->calibration_, 7);
+ * this->bus_->submit(std::move(transaction), [this](i2c::ErrorCode err) { this->handle_data_(err); });
+ * @endcode
+ */
+class I2CTransaction {
+ public:
+  /**
+   * @param address The address of the device.
+   * @param deadline The time in milliseconds the transaction should run at, for example after a conversion delay.
+   */
+  I2CTransaction(uint8_t address, uint32_t deadline) : address_(address), deadline_(deadline) {}
+
+  I2CTransaction &write(const uint8_t *data, size_t len);
+  I2CTransaction &read(uint8_t *data, size_t len);
+  I2CTransaction &write_register(uint8_t a_register, const uint8_t *data, size_t len);
+  I2CTransaction &read_register(uint8_t a_register, uint8_t *data, size_t len);
+
+  uint8_t get_address() const { return this->address_; }
+  uint32_t get_deadline() const { return this->deadline_; }
+
+ protected:
+  friend class I2CBus;
+
+  struct Operation {
+    /// Where to read to, or nullptr for a write of len bytes at offset in write_data_.
+    uint8_t *read_data;
+    size_t offset;
+    size_t len;
+  };
+
+  uint8_t address_;
+  uint32_t deadline_;
+  std::vector<Operation> operations_;
+  std::vector<uint8_t> write_data_;
+  std::function<void(ErrorCode)> callback_;
+};
+
 class I2CBus {
  public:
   virtual ErrorCode read(uint8_t address, uint8_t *buffer, size_t len) {
@@ -43,7 +90,35 @@ class I2CBus {
   }
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt) = 0;
 
+  /** Queue a transaction to run once its deadline is reached.
+   *
+   * Due transactions are run back to back from the bus' loop(), earliest deadline first, instead of each device
+   * accessing the bus from its own timeout. The callback gets the result of the transaction.
+   */
+  void submit(I2CTransaction &&transaction, std::function<void(ErrorCode)> &&callback);
+  /// The share of time spent running transactions since the statistics were last logged, from 0 to 1.
+  float get_utilisation() const;
+
  protected:
+  /// Run all due transactions, called from the bus' loop().
+  void process_transactions_();
+  ErrorCode run_transaction_(I2CTransaction &transaction);
+
+  struct DeviceStats {
+    uint8_t address;
+    uint32_t count;
+    /// Time in milliseconds transactions ran after their deadline.
+    uint32_t latency_total;
+    uint32_t latency_max;
+  };
+
+  /// Queued transactions sorted by deadline.
+  std::vector<I2CTransaction> transactions_;
+  std::vector<DeviceStats> device_stats_;
+  uint32_t stats_start_{0};
+  /// Time in microseconds spent running transactions since stats_start_.
+  uint32_t busy_time_{0};
+
   void i2c_scan_() {
     for (uint8_t address = 8; address < 120; address++) {
       auto err = writev(address, nullptr, 0);
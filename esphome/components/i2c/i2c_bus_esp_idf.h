@@ -18,6 +18,7 @@ enum RecoveryCode {
 class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
+  void loop() override { this->process_transactions_(); }
   void dump_config() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt) override;
@@ -92,13 +92,18 @@ void ILI9341Display::display_() {
   set_addr_window_(this->x_low_, this->y_low_, w, h);
   this->start_data_();
   uint32_t start_pos = ((this->y_low_ * this->width_) + x_low_);
+  uint8_t next_buffer = 0;
   for (uint16_t row = 0; row < h; row++) {
     uint32_t pos = start_pos + (row * width_);
     uint32_t rem = w;
 
     while (rem > 0) {
-      uint32_t sz = buffer_to_transfer_(pos, rem);
-      this->write_array(transfer_buffer_, 2 * sz);
+      // Convert the next chunk while the previous one is being written, the one before must be done by now
+      this->wait_queued_writes(1);
+      uint8_t *transfer_buffer = this->transfer_buffer_[next_buffer];
+      uint32_t sz = buffer_to_transfer_(transfer_buffer, pos, rem);
+      this->queue_write(transfer_buffer, 2 * sz);
+      next_buffer ^= 1;
       pos += sz;
       rem -= sz;
     }
@@ -142,13 +147,14 @@ void ILI9341Display::fill(Color color) {
 }
 
 void ILI9341Display::fill_internal_(Color color) {
+  uint8_t *transfer_buffer = transfer_buffer_[0];
   if (color.raw_32 == Color::BLACK.raw_32) {
-    memset(transfer_buffer_, 0, sizeof(transfer_buffer_));
+    memset(transfer_buffer, 0, sizeof(transfer_buffer_[0]));
   } else {
-    uint8_t *dst = transfer_buffer_;
+    uint8_t *dst = transfer_buffer;
     auto color565 = display::ColorUtil::color_to_565(color);
 
-    while (dst < transfer_buffer_ + sizeof(transfer_buffer_)) {
+    while (dst < transfer_buffer + sizeof(transfer_buffer_[0])) {
       *dst++ = (uint8_t)(color565 >> 8);
       *dst++ = (uint8_t) color565;
     }
@@ -160,8 +166,8 @@ void ILI9341Display::fill_internal_(Color color) {
   this->start_data_();
 
   while (rem > 0) {
-    size_t sz = rem <= sizeof(transfer_buffer_) ? rem : sizeof(transfer_buffer_);
-    this->write_array(transfer_buffer_, sz);
+    size_t sz = rem <= sizeof(transfer_buffer_[0]) ? rem : sizeof(transfer_buffer_[0]);
+    this->write_array(transfer_buffer, sz);
     rem -= sz;
   }
 
@@ -238,12 +244,11 @@ void ILI9341Display::invert_display_(bool invert) { this->command(invert ? ILI93
 int ILI9341Display::get_width_internal() { return this->width_; }
 int ILI9341Display::get_height_internal() { return this->height_; }
 
-uint32_t ILI9341Display::buffer_to_transfer_(uint32_t pos, uint32_t sz) {
+uint32_t ILI9341Display::buffer_to_transfer_(uint8_t *dst, uint32_t pos, uint32_t sz) {
   uint8_t *src = buffer_ + pos;
-  uint8_t *dst = transfer_buffer_;
 
-  if (sz > sizeof(transfer_buffer_) / 2) {
-    sz = sizeof(transfer_buffer_) / 2;
+  if (sz > sizeof(transfer_buffer_[0]) / 2) {
+    sz = sizeof(transfer_buffer_[0]) / 2;
   }
 
   for (uint32_t i = 0; i < sz; ++i) {
@@ -71,9 +71,10 @@ class ILI9341Display : public PollingComponent,
   void start_data_();
   void end_data_();
 
-  uint8_t transfer_buffer_[64];
+  /// Two buffers, so one can be filled while the other one is written to the display.
+  uint8_t transfer_buffer_[2][256];
 
-  uint32_t buffer_to_transfer_(uint32_t pos, uint32_t sz);
+  uint32_t buffer_to_transfer_(uint8_t *dst, uint32_t pos, uint32_t sz);
 
   GPIOPin *reset_pin_{nullptr};
   GPIOPin *led_pin_{nullptr};
@@ -1 +1,24 @@
+import esphome.codegen as cg
+from esphome.core import CORE, ID
+
 CODEOWNERS = ["@OttoWinter"]
+
+integration_ns = cg.esphome_ns.namespace("integration")
+AccumulatorStore = integration_ns.class_("AccumulatorStore", cg.Component)
+
+KEY_ACCUMULATOR_STORE = "integration_accumulator_store"
+
+
+async def get_accumulator_store():
+    """Get the store that saves the totals of all accumulators in one preference.
+
+    The store is created by the first component that needs it.
+    """
+    if KEY_ACCUMULATOR_STORE not in CORE.data:
+        store_id = ID(
+            "integration_accumulator_store", is_declaration=True, type=AccumulatorStore
+        )
+        store = cg.new_Pvariable(store_id)
+        await cg.register_component(store, {})
+        CORE.data[KEY_ACCUMULATOR_STORE] = store
+    return CORE.data[KEY_ACCUMULATOR_STORE]
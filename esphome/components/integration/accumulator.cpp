@@ -0,0 +1,205 @@
+#include "accumulator.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace esphome {
+namespace integration {
+
+static const char *const TAG = "integration.accumulator";
+
+/// The largest sample value, the fixed point sum of two samples stays below 2^39.
+static const float MAX_VALUE = 4194304.0f;
+/// The longest time step that is added at once, so the area of a step never exceeds 2^62.
+static const uint32_t MAX_STEP = 1UL << 23;
+/// Fold the remainder into whole units once it gets this large, so adding another step can't overflow.
+static const int64_t FOLD_LIMIT = int64_t(1) << 61;
+
+void Accumulator::set_time_unit(uint32_t unit_ms) { this->unit_ = int64_t(unit_ms) << (FRACTIONAL_BITS + 1); }
+
+void Accumulator::start(uint32_t time) {
+  this->last_value_ = 0;
+  this->last_time_ = time;
+}
+
+void Accumulator::add_sample(uint32_t time, float value) {
+  if (std::isnan(value))
+    return;
+  if (value > MAX_VALUE || value < -MAX_VALUE) {
+    if (!this->logged_clamp_) {
+      ESP_LOGW(TAG, "Value %f is out of range, it's counted as %.0f", value, std::copysign(MAX_VALUE, value));
+      this->logged_clamp_ = true;
+    }
+    value = clamp(value, -MAX_VALUE, MAX_VALUE);
+  }
+  const int64_t fixed = llroundf(value * (1UL << FRACTIONAL_BITS));
+  if (fixed == 0 && value != 0.0f && !this->logged_underflow_) {
+    ESP_LOGW(TAG, "Value %g is below the resolution of 1/%u, it's counted as 0", value, 1U << FRACTIONAL_BITS);
+    this->logged_underflow_ = true;
+  }
+
+  // The sum of both heights of the trapezoid, the rectangle methods count their height twice
+  int64_t heights;
+  switch (this->method_) {
+    case INTEGRATION_METHOD_LEFT:
+      heights = 2 * this->last_value_;
+      break;
+    case INTEGRATION_METHOD_RIGHT:
+      heights = 2 * fixed;
+      break;
+    case INTEGRATION_METHOD_TRAPEZOID:
+    default:
+      heights = this->last_value_ + fixed;
+      break;
+  }
+
+  uint32_t dt = time - this->last_time_;
+  while (dt != 0) {
+    uint32_t step = std::min(dt, MAX_STEP);
+    this->remainder_ += heights * step;
+    dt -= step;
+    if (this->remainder_ > FOLD_LIMIT || this->remainder_ < -FOLD_LIMIT)
+      this->fold_();
+  }
+
+  this->last_value_ = fixed;
+  this->last_time_ = time;
+}
+
+void Accumulator::add_samples(const Sample *samples, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    this->add_sample(samples[i].time, samples[i].value);
+}
+
+double Accumulator::get_total() const {
+  const int64_t whole = this->whole_ + this->remainder_ / this->unit_;
+  return double(whole) + double(this->remainder_ % this->unit_) / double(this->unit_);
+}
+
+void Accumulator::set_total(double total) {
+  this->whole_ = int64_t(std::trunc(total));
+  this->remainder_ = llround((total - double(this->whole_)) * double(this->unit_));
+}
+
+void Accumulator::get_total(int64_t &whole, uint32_t &fraction) const {
+  whole = this->whole_ + this->remainder_ / this->unit_;
+  int64_t remainder = this->remainder_ % this->unit_;
+  if (remainder < 0) {
+    whole--;
+    remainder += this->unit_;
+  }
+  fraction = uint32_t(std::min(double(remainder) / double(this->unit_) * 4294967296.0, 4294967295.0));
+}
+
+void Accumulator::set_total(int64_t whole, uint32_t fraction) {
+  this->whole_ = whole;
+  this->remainder_ = llround(fraction / 4294967296.0 * double(this->unit_));
+}
+
+void Accumulator::fold_() {
+  this->whole_ += this->remainder_ / this->unit_;
+  this->remainder_ %= this->unit_;
+}
+
+void AccumulatorStore::add(uint32_t key, Accumulator *accumulator, uint32_t min_save_interval) {
+  this->entries_.push_back(Entry{key, accumulator});
+  this->min_save_interval_ = std::min(this->min_save_interval_, min_save_interval);
+}
+
+void AccumulatorStore::restore(Accumulator *accumulator) {
+  if (!this->loaded_)
+    this->load_();
+
+  for (auto &entry : this->entries_) {
+    if (entry.accumulator != accumulator)
+      continue;
+    for (auto &saved : this->totals_) {
+      if (saved.key == entry.key) {
+        accumulator->set_total(saved.whole, saved.fraction);
+        return;
+      }
+    }
+
+    // Saved before the totals were kept in the store
+    float total;
+    auto legacy = global_preferences->make_preference<float>(entry.key);
+    if (legacy.load(&total)) {
+      ESP_LOGD(TAG, "Restored total %f saved by an older version", total);
+      accumulator->set_total(total);
+      this->mark_dirty();
+    }
+    return;
+  }
+}
+
+void AccumulatorStore::mark_dirty() {
+  if (this->save_pending_)
+    return;
+  this->save_pending_ = true;
+  uint32_t since_save = millis() - this->last_save_;
+  uint32_t delay = since_save >= this->min_save_interval_ ? 0 : this->min_save_interval_ - since_save;
+  this->set_timeout("save", delay, [this]() { this->save_(); });
+}
+
+void AccumulatorStore::on_safe_shutdown() {
+  if (!this->save_pending_)
+    return;
+  this->cancel_timeout("save");
+  this->save_();
+}
+
+void AccumulatorStore::on_shutdown() {
+  if (!this->save_pending_)
+    return;
+  this->on_safe_shutdown();
+  // The preferences may already have been synced for this shutdown, so write this save out too
+  global_preferences->sync();
+}
+
+void AccumulatorStore::load_() {
+  this->loaded_ = true;
+  this->last_save_ = millis();
+
+  size_t records = (this->entries_.size() + RECORD_GROUP - 1) / RECORD_GROUP;
+  this->totals_.resize(records * RECORD_GROUP);
+  for (size_t i = 0; i < records; i++) {
+    this->prefs_.push_back(global_preferences->make_preference(RECORD_GROUP * sizeof(SavedTotal),
+                                                               fnv1_hash("integration_accumulators_" + to_string(i))));
+    SavedTotal *totals = &this->totals_[i * RECORD_GROUP];
+    if (!this->prefs_[i].load(reinterpret_cast<uint8_t *>(totals), RECORD_GROUP * sizeof(SavedTotal))) {
+      ESP_LOGD(TAG, "No saved totals in record %zu", i);
+      std::fill(totals, totals + RECORD_GROUP, SavedTotal{0, 0, 0});
+    }
+  }
+}
+
+void AccumulatorStore::save_() {
+  if (!this->loaded_)
+    this->load_();
+  this->save_pending_ = false;
+  this->last_save_ = millis();
+
+  SavedTotal totals[RECORD_GROUP];
+  for (size_t i = 0; i < this->prefs_.size(); i++) {
+    for (size_t j = 0; j < RECORD_GROUP; j++) {
+      size_t index = i * RECORD_GROUP + j;
+      totals[j] = SavedTotal{0, 0, 0};
+      if (index < this->entries_.size()) {
+        totals[j].key = this->entries_[index].key;
+        this->entries_[index].accumulator->get_total(totals[j].whole, totals[j].fraction);
+      }
+    }
+    SavedTotal *saved = &this->totals_[i * RECORD_GROUP];
+    if (memcmp(totals, saved, sizeof(totals)) == 0)
+      continue;
+    memcpy(saved, totals, sizeof(totals));
+    this->prefs_[i].save(reinterpret_cast<const uint8_t *>(saved), sizeof(totals));
+  }
+}
+
+}  // namespace integration
+}  // namespace esphome
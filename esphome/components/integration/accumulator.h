@@ -0,0 +1,123 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace integration {
+
+enum IntegrationMethod {
+  INTEGRATION_METHOD_TRAPEZOID = 0,
+  INTEGRATION_METHOD_LEFT,
+  INTEGRATION_METHOD_RIGHT,
+};
+
+/** Integrates samples of a value over time, for example power into energy.
+ *
+ * Samples are converted to fixed point with FRACTIONAL_BITS fractional bits, after which the area under them is summed
+ * up exactly in 64-bit integers. The total is kept as a whole number of time units plus a remainder, so adding a small
+ * area to a large total doesn't lose precision and there is no drift no matter how many samples are added.
+ *
+ * Sample values are limited to +-4194304 (2^22) and rounded to a resolution of 1/65536 (2^-16). Larger values are
+ * clamped and non-zero values that round to 0 are counted as 0, both are logged once per accumulator. NaN samples
+ * are ignored.
+ */
+class Accumulator {
+ public:
+  static const uint8_t FRACTIONAL_BITS = 16;
+
+  struct Sample {
+    /// The time of the sample in milliseconds.
+    uint32_t time;
+    float value;
+  };
+
+  void set_method(IntegrationMethod method) { this->method_ = method; }
+  /// Set the length of the time unit the total is in, in milliseconds. For example 3600000 for power in W to Wh.
+  void set_time_unit(uint32_t unit_ms);
+
+  /// Start integrating at time, as if the value was 0 until then.
+  void start(uint32_t time);
+  /// Add the area between the previous sample and this one.
+  void add_sample(uint32_t time, float value);
+  /// Add multiple samples at once, in order of their time.
+  void add_samples(const Sample *samples, size_t count);
+
+  /// The sum of the area of all samples, in value * time units.
+  double get_total() const;
+  void set_total(double total);
+  /// The total as whole time units plus a fraction of a time unit in 1/2^32, for saving it without losing precision.
+  void get_total(int64_t &whole, uint32_t &fraction) const;
+  void set_total(int64_t whole, uint32_t fraction);
+
+ protected:
+  /// Move whole time units from the remainder to whole_.
+  void fold_();
+
+  IntegrationMethod method_{INTEGRATION_METHOD_TRAPEZOID};
+  /// The area of one value * time unit, in value * ms * 2^(FRACTIONAL_BITS + 1).
+  int64_t unit_{int64_t(1) << (FRACTIONAL_BITS + 1)};
+  /// The total is whole_ + remainder_ / unit_.
+  int64_t whole_{0};
+  int64_t remainder_{0};
+  int64_t last_value_{0};
+  uint32_t last_time_{0};
+  bool logged_clamp_{false};
+  bool logged_underflow_{false};
+};
+
+/** Saves the totals of accumulators in a few fixed-size preferences, instead of one preference per sensor.
+ *
+ * Every total takes 16 bytes. The totals are saved in records of RECORD_GROUP totals each, so adding or removing a
+ * sensor never changes the size of a record and the saved totals are kept. Totals are found by the key of their
+ * accumulator, in any record. A total that isn't in any record is restored from the float preference accumulators
+ * were saved in before. Saves are delayed to at most one per minimum save interval of the accumulators, changes of
+ * several accumulators are saved together and only records that changed are written.
+ */
+class AccumulatorStore : public Component {
+ public:
+  static const size_t RECORD_GROUP = 8;
+
+  /// Add an accumulator to the store, must be called before any restore().
+  void add(uint32_t key, Accumulator *accumulator, uint32_t min_save_interval);
+  /// Set the total of an accumulator to its saved value, the first call loads the record.
+  void restore(Accumulator *accumulator);
+  /// Save the totals, after the minimum save interval has passed since the previous save.
+  void mark_dirty();
+
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  /// Save pending changes right away instead of losing them on reboot.
+  void on_safe_shutdown() override;
+  void on_shutdown() override;
+
+ protected:
+  struct Entry {
+    uint32_t key;
+    Accumulator *accumulator;
+  };
+  struct SavedTotal {
+    uint32_t key;
+    /// The fraction of the total in 1/2^32.
+    uint32_t fraction;
+    int64_t whole;
+  };
+
+  void load_();
+  void save_();
+
+  std::vector<Entry> entries_;
+  /// The saved totals, record i is stored in prefs_[i] and holds totals_[i * RECORD_GROUP] up to the next record.
+  std::vector<SavedTotal> totals_;
+  std::vector<ESPPreferenceObject> prefs_;
+  bool loaded_{false};
+  bool save_pending_{false};
+  uint32_t last_save_{0};
+  uint32_t min_save_interval_{UINT32_MAX};
+};
+
+}  // namespace integration
+}  // namespace esphome
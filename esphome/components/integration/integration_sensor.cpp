@@ -9,41 +9,22 @@ namespace integration {
 static const char *const TAG = "integration";
 
 void IntegrationSensor::setup() {
-  if (this->restore_) {
-    this->rtc_ = global_preferences->make_preference<float>(this->get_object_id_hash());
-    float preference_value = 0;
-    this->rtc_.load(&preference_value);
-    this->result_ = preference_value;
-  }
+  this->accumulator_.set_time_unit(this->get_time_unit_ms_());
+  if (this->store_ != nullptr)
+    this->store_->restore(&this->accumulator_);
+  this->accumulator_.start(millis());
 
-  this->last_update_ = millis();
-  this->last_save_ = this->last_update_;
-
-  this->publish_and_save_(this->result_);
+  this->publish_state(this->accumulator_.get_total());
   this->sensor_->add_on_state_callback([this](float state) { this->process_sensor_value_(state); });
 }
 void IntegrationSensor::dump_config() { LOG_SENSOR("", "Integration Sensor", this); }
+void IntegrationSensor::set_store(AccumulatorStore *store, uint32_t min_save_interval) {
+  this->store_ = store;
+  store->add(this->get_object_id_hash(), &this->accumulator_, min_save_interval);
+}
 void IntegrationSensor::process_sensor_value_(float value) {
-  const uint32_t now = millis();
-  const double old_value = this->last_value_;
-  const double new_value = value;
-  const uint32_t dt_ms = now - this->last_update_;
-  const double dt = dt_ms * this->get_time_factor_();
-  double area = 0.0f;
-  switch (this->method_) {
-    case INTEGRATION_METHOD_TRAPEZOID:
-      area = dt * (old_value + new_value) / 2.0;
-      break;
-    case INTEGRATION_METHOD_LEFT:
-      area = dt * old_value;
-      break;
-    case INTEGRATION_METHOD_RIGHT:
-      area = dt * new_value;
-      break;
-  }
-  this->last_value_ = new_value;
-  this->last_update_ = now;
-  this->publish_and_save_(this->result_ + area);
+  this->accumulator_.add_sample(millis(), value);
+  this->publish_and_save_();
 }
 
 }  // namespace integration
@@ -5,6 +5,7 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/hal.h"
 #include "esphome/components/sensor/sensor.h"
+#include "accumulator.h"
 
 namespace esphome {
 namespace integration {
@@ -17,64 +18,49 @@ enum IntegrationSensorTime {
   INTEGRATION_SENSOR_TIME_DAY,
 };
 
-enum IntegrationMethod {
-  INTEGRATION_METHOD_TRAPEZOID = 0,
-  INTEGRATION_METHOD_LEFT,
-  INTEGRATION_METHOD_RIGHT,
-};
-
 class IntegrationSensor : public sensor::Sensor, public Component {
  public:
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
-  void set_min_save_interval(uint32_t min_interval) { this->min_save_interval_ = min_interval; }
   void set_sensor(Sensor *sensor) { sensor_ = sensor; }
   void set_time(IntegrationSensorTime time) { time_ = time; }
-  void set_method(IntegrationMethod method) { method_ = method; }
-  void set_restore(bool restore) { restore_ = restore; }
-  void reset() { this->publish_and_save_(0.0f); }
+  void set_method(IntegrationMethod method) { this->accumulator_.set_method(method); }
+  /// Restore the total from and save it to store, at most once per min_save_interval ms.
+  void set_store(AccumulatorStore *store, uint32_t min_save_interval);
+  void reset() {
+    this->accumulator_.set_total(0.0);
+    this->publish_and_save_();
+  }
 
  protected:
   void process_sensor_value_(float value);
-  float get_time_factor_() {
+  uint32_t get_time_unit_ms_() {
     switch (this->time_) {
       case INTEGRATION_SENSOR_TIME_MILLISECOND:
-        return 1.0f;
+        return 1;
       case INTEGRATION_SENSOR_TIME_SECOND:
-        return 1.0f / 1000.0f;
+        return 1000;
       case INTEGRATION_SENSOR_TIME_MINUTE:
-        return 1.0f / 60000.0f;
+        return 60000;
       case INTEGRATION_SENSOR_TIME_HOUR:
-        return 1.0f / 3600000.0f;
+        return 3600000;
       case INTEGRATION_SENSOR_TIME_DAY:
-        return 1.0f / 86400000.0f;
+        return 86400000;
       default:
-        return 0.0f;
+        return 1;
     }
   }
-  void publish_and_save_(double result) {
-    this->result_ = result;
-    this->publish_state(result);
-    float result_f = result;
-    const uint32_t now = millis();
-    if (now - this->last_save_ < this->min_save_interval_)
-      return;
-    this->last_save_ = now;
-    this->rtc_.save(&result_f);
+  void publish_and_save_() {
+    this->publish_state(this->accumulator_.get_total());
+    if (this->store_ != nullptr)
+      this->store_->mark_dirty();
   }
 
   sensor::Sensor *sensor_;
   IntegrationSensorTime time_;
-  IntegrationMethod method_;
-  bool restore_;
-  ESPPreferenceObject rtc_;
-
-  uint32_t last_save_{0};
-  uint32_t min_save_interval_{0};
-  uint32_t last_update_;
-  double result_{0.0f};
-  float last_value_{0.0f};
+  Accumulator accumulator_;
+  AccumulatorStore *store_{nullptr};
 };
 
 template<typename... Ts> class ResetAction : public Action<Ts...> {
@@ -11,8 +11,8 @@ from esphome.const import (
     CONF_ACCURACY_DECIMALS,
 )
 from esphome.core.entity_helpers import inherit_property_from
+from . import integration_ns, get_accumulator_store
 
-integration_ns = cg.esphome_ns.namespace("integration")
 IntegrationSensor = integration_ns.class_(
     "IntegrationSensor", sensor.Sensor, cg.Component
 )
@@ -49,6 +49,8 @@ def inherit_accuracy_decimals(decimals, config):
     return decimals + 2
 
 
+# The source sensor's values are integrated in fixed point: they are limited to
+# +-4194304 and rounded to 1/65536, values outside of that are logged once.
 CONFIG_SCHEMA = sensor.SENSOR_SCHEMA.extend(
     {
         cv.GenerateID(): cv.declare_id(IntegrationSensor),
@@ -96,8 +98,9 @@ async def to_code(config):
     cg.add(var.set_sensor(sens))
     cg.add(var.set_time(config[CONF_TIME_UNIT]))
     cg.add(var.set_method(config[CONF_INTEGRATION_METHOD]))
-    cg.add(var.set_restore(config[CONF_RESTORE]))
-    cg.add(var.set_min_save_interval(config[CONF_MIN_SAVE_INTERVAL]))
+    if config[CONF_RESTORE]:
+        store = await get_accumulator_store()
+        cg.add(var.set_store(store, config[CONF_MIN_SAVE_INTERVAL]))
 
 
 @automation.register_action(
@@ -4,6 +4,7 @@
 #include "esphome/core/entity_base.h"
 #include "esphome/core/optional.h"
 #include "esphome/core/preferences.h"
+#include "esphome/core/state_journal.h"
 #include "light_call.h"
 #include "light_color_values.h"
 #include "light_effect.h"
@@ -180,7 +181,7 @@ class LightState : public EntityBase, public Component {
   bool next_write_{true};
 
   /// Object used to store the persisted values of the light.
-  ESPPreferenceObject rtc_;
+  StateJournalRecord rtc_;
 
   /** Callback to call when new values for the frontend are available.
    *
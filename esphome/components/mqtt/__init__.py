@@ -46,6 +46,8 @@ from esphome.core import coroutine_with_priority, CORE
 DEPENDENCIES = ["network"]
 AUTO_LOAD = ["json", "async_tcp"]
 
+CONF_PUBLISH_BATCH_WINDOW = "publish_batch_window"
+
 
 def validate_message_just_topic(value):
     value = cv.publish_topic(value)
@@ -197,6 +199,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(
+                CONF_PUBLISH_BATCH_WINDOW, default="0ms"
+            ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_ON_MESSAGE): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(MQTTMessageTrigger),
@@ -321,6 +326,8 @@ async def to_code(config):
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
 
+    cg.add(var.set_publish_batch_window(config[CONF_PUBLISH_BATCH_WINDOW]))
+
     for conf in config.get(CONF_ON_MESSAGE, []):
         trig = cg.new_Pvariable(conf[CONF_TRIGGER_ID], conf[CONF_TOPIC])
         cg.add(trig.set_qos(conf[CONF_QOS]))
@@ -6,6 +6,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include "esphome/components/network/util.h"
+#include <algorithm>
 #include <utility>
 #ifdef USE_LOGGER
 #include "esphome/components/logger/logger.h"
@@ -19,6 +20,14 @@ namespace mqtt {
 
 static const char *const TAG = "mqtt";
 
+/// Stop sending scheduled discovery messages and states for this loop iteration after this many bytes.
+static const uint32_t RESEND_MAX_BYTES_PER_LOOP = 2048;
+/// Stop sending scheduled discovery messages and states for this loop iteration after this many milliseconds.
+static const uint32_t RESEND_MAX_TIME_PER_LOOP = 10;
+/// Flags of MQTTClientComponent::discovery_counted_.
+static const uint8_t DISCOVERY_COUNTED_PROCESSED = 1 << 0;
+static const uint8_t DISCOVERY_COUNTED_FAILED = 1 << 1;
+
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
   this->credentials_.client_id = App.get_name() + "-" + get_mac_address();
@@ -56,6 +65,15 @@ void MQTTClientComponent::setup() {
   }
 #endif
 
+  if (this->is_discovery_enabled()) {
+    // Home Assistant announces itself after it (re)started, it may have missed or lost the discovery messages
+    this->subscribe(this->discovery_info_.prefix + "/status",
+                    [this](const std::string &topic, const std::string &payload) {
+                      if (payload == "online")
+                        this->discovery_resend_requested_ = true;
+                    });
+  }
+
   this->last_connected_ = millis();
   this->start_dnslookup_();
 }
@@ -217,6 +235,14 @@ void MQTTClientComponent::check_connected() {
 
   this->resubscribe_subscriptions_();
 
+  this->start_discovery_pass_();
+}
+
+void MQTTClientComponent::start_discovery_pass_() {
+  this->discovery_progress_ = {};
+  this->discovery_progress_.total = this->children_.size();
+  this->discovery_counted_.assign(this->children_.size(), 0);
+  this->resend_index_ = 0;
   for (MQTTComponent *component : this->children_)
     component->schedule_resend_state();
 }
@@ -278,11 +304,26 @@ void MQTTClientComponent::loop() {
       if (!this->mqtt_client_.connected()) {
         this->state_ = MQTT_CLIENT_DISCONNECTED;
         ESP_LOGW(TAG, "Lost MQTT Client connection!");
+        // All components resend their state after reconnecting
+        this->publish_queue_size_ = 0;
         this->start_dnslookup_();
       } else {
         if (!this->birth_message_.topic.empty() && !this->sent_birth_message_) {
           this->sent_birth_message_ = this->publish(this->birth_message_);
         }
+        if (this->discovery_resend_requested_) {
+          this->discovery_resend_requested_ = false;
+          ESP_LOGD(TAG, "Home Assistant came online, sending discovery messages again");
+          for (MQTTComponent *component : this->children_)
+            component->clear_discovery_hash();
+          this->start_discovery_pass_();
+        }
+        if (this->resend_scheduled_) {
+          this->send_scheduled_states_();
+        }
+        if (this->publish_queue_size_ != 0 && now - this->publish_queue_since_ >= this->publish_batch_window_) {
+          this->flush_publish_queue_();
+        }
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
@@ -392,6 +433,19 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
     return false;
   }
   bool logging_topic = topic == this->log_message_.topic;
+  if (!logging_topic && this->publish_queue_size_ != 0) {
+    // Don't let queued messages overtake this one
+    this->flush_publish_queue_();
+    // A queued message to this topic that couldn't be sent is outdated now
+    for (size_t i = 0; i < this->publish_queue_size_; i++) {
+      if (this->publish_queue_[i].topic == topic) {
+        auto begin = this->publish_queue_.begin();
+        std::rotate(begin + i, begin + i + 1, begin + this->publish_queue_size_);
+        this->publish_queue_size_--;
+        break;
+      }
+    }
+  }
   uint16_t ret = this->mqtt_client_.publish(topic.c_str(), qos, retain, payload, payload_length);
   delay(0);
   if (ret == 0 && !logging_topic && this->is_connected()) {
@@ -400,6 +454,9 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
     delay(0);
   }
 
+  if (ret != 0)
+    this->published_bytes_ += topic.size() + payload_length;
+
   if (!logging_topic) {
     if (ret != 0) {
       ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d)", topic.c_str(), payload, retain);
@@ -412,6 +469,104 @@ bool MQTTClientComponent::publish(const std::string &topic, const char *payload,
   return ret != 0;
 }
 
+bool MQTTClientComponent::publish_batched(const std::string &topic, const std::string &payload, bool retain) {
+  if (this->publish_batch_window_ == 0)
+    return this->publish(topic, payload, 0, retain);
+  if (!this->is_connected()) {
+    // critical components will re-transmit their messages
+    return false;
+  }
+
+  for (size_t i = 0; i < this->publish_queue_size_; i++) {
+    MQTTMessage &message = this->publish_queue_[i];
+    if (message.topic == topic) {
+      message.payload.assign(payload);
+      message.retain = retain;
+      return true;
+    }
+  }
+
+  if (this->publish_queue_size_ == 0)
+    this->publish_queue_since_ = millis();
+  if (this->publish_queue_size_ == this->publish_queue_.size())
+    this->publish_queue_.emplace_back();
+  MQTTMessage &message = this->publish_queue_[this->publish_queue_size_++];
+  message.topic.assign(topic);
+  message.payload.assign(payload);
+  message.qos = 0;
+  message.retain = retain;
+  return true;
+}
+void MQTTClientComponent::flush_publish_queue_() {
+  // Reset the size first, publish() flushes the queue itself if it isn't empty
+  size_t size = this->publish_queue_size_;
+  this->publish_queue_size_ = 0;
+  size_t sent = 0;
+  while (sent < size) {
+    const MQTTMessage &message = this->publish_queue_[sent];
+    if (!this->publish(message.topic, message.payload, message.qos, message.retain))
+      break;
+    sent++;
+  }
+  if (sent == size)
+    return;
+
+  // Keep the messages that weren't sent in order and retry them after the next batch window
+  auto begin = this->publish_queue_.begin();
+  std::rotate(begin, begin + sent, begin + size);
+  this->publish_queue_size_ = size - sent;
+  this->publish_queue_since_ = millis();
+}
+void MQTTClientComponent::send_scheduled_states_() {
+  const uint32_t start = millis();
+  const uint32_t start_bytes = this->published_bytes_;
+  bool any_scheduled = false;
+  for (size_t i = 0; i < this->children_.size(); i++) {
+    if (this->resend_index_ >= this->children_.size())
+      this->resend_index_ = 0;
+    const size_t index = this->resend_index_++;
+    MQTTComponent *component = this->children_[index];
+    if (!component->is_resend_scheduled())
+      continue;
+
+    any_scheduled = true;
+    MQTTDiscoveryResult result = component->send_scheduled_state();
+    // Count every component once, no matter how often it's retried
+    uint8_t &counted = this->discovery_counted_[index];
+    if (result == MQTT_DISCOVERY_FAILED) {
+      if ((counted & DISCOVERY_COUNTED_FAILED) == 0) {
+        counted |= DISCOVERY_COUNTED_FAILED;
+        this->discovery_progress_.failed++;
+      }
+      // The send buffer is most likely full, retry in the next loop iteration
+      return;
+    }
+    if ((counted & DISCOVERY_COUNTED_PROCESSED) == 0) {
+      counted |= DISCOVERY_COUNTED_PROCESSED;
+      this->discovery_progress_.processed++;
+      if (result == MQTT_DISCOVERY_SENT) {
+        this->discovery_progress_.sent++;
+      } else if (result == MQTT_DISCOVERY_UNCHANGED) {
+        this->discovery_progress_.unchanged++;
+      }
+    }
+
+    if (this->published_bytes_ - start_bytes >= RESEND_MAX_BYTES_PER_LOOP ||
+        millis() - start >= RESEND_MAX_TIME_PER_LOOP)
+      return;
+  }
+  if (any_scheduled)
+    return;
+
+  // A full pass over all components found nothing left to send
+  this->resend_scheduled_ = false;
+  this->discovery_progress_.complete = true;
+  if (!this->is_discovery_enabled())
+    return;
+
+  ESP_LOGD(TAG, "Discovery complete: %u sent, %u unchanged, %u retried", this->discovery_progress_.sent,
+           this->discovery_progress_.unchanged, this->discovery_progress_.failed);
+}
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
   return this->publish(message.topic, message.payload, message.qos, message.retain);
 }
@@ -502,7 +657,10 @@ void MQTTClientComponent::set_log_level(int level) { this->log_level_ = level; }
 void MQTTClientComponent::set_keep_alive(uint16_t keep_alive_s) { this->mqtt_client_.setKeepAlive(keep_alive_s); }
 void MQTTClientComponent::set_log_message_template(MQTTMessage &&message) { this->log_message_ = std::move(message); }
 const MQTTDiscoveryInfo &MQTTClientComponent::get_discovery_info() const { return this->discovery_info_; }
-void MQTTClientComponent::set_topic_prefix(std::string topic_prefix) { this->topic_prefix_ = std::move(topic_prefix); }
+void MQTTClientComponent::set_topic_prefix(std::string topic_prefix) {
+  this->topic_prefix_ = std::move(topic_prefix);
+  this->topic_prefix_generation_++;
+}
 const std::string &MQTTClientComponent::get_topic_prefix() const { return this->topic_prefix_; }
 void MQTTClientComponent::disable_birth_message() {
   this->birth_message_.topic = "";
@@ -86,6 +86,24 @@ enum MQTTClientState {
   MQTT_CLIENT_CONNECTED,
 };
 
+/// Outcome of sending the discovery message of a single MQTT component.
+enum MQTTDiscoveryResult {
+  MQTT_DISCOVERY_DISABLED = 0,
+  MQTT_DISCOVERY_SENT,
+  MQTT_DISCOVERY_UNCHANGED,
+  MQTT_DISCOVERY_FAILED,
+};
+
+/// Progress of sending the discovery messages and states of all MQTT components after connecting.
+struct MQTTDiscoveryProgress {
+  uint32_t total;      ///< Number of MQTT components when the connection was established.
+  uint32_t processed;  ///< Number of components whose discovery message and state were handled.
+  uint32_t sent;       ///< Number of components whose discovery message was published.
+  uint32_t unchanged;  ///< Number of components whose retained discovery message was still up to date.
+  uint32_t failed;     ///< Number of components whose discovery message failed at least once and was retried.
+  bool complete;       ///< Whether there are no scheduled resends left.
+};
+
 class MQTTComponent;
 
 class MQTTClientComponent : public Component {
@@ -123,6 +141,8 @@ class MQTTClientComponent : public Component {
   /// Globally disable Home Assistant discovery.
   void disable_discovery();
   bool is_discovery_enabled() const;
+  /// Get the progress of sending discovery messages since the last connection.
+  const MQTTDiscoveryProgress &get_discovery_progress() const { return this->discovery_progress_; }
 
 #if ASYNC_TCP_SSL_ENABLED
   /** Add a SSL fingerprint to use for TCP SSL connections to the MQTT broker.
@@ -153,6 +173,8 @@ class MQTTClientComponent : public Component {
   void set_topic_prefix(std::string topic_prefix);
   /// Get the topic prefix of this device, using default if necessary
   const std::string &get_topic_prefix() const;
+  /// Incremented whenever the topic prefix is set, so topics built from it can tell if they are outdated.
+  uint32_t get_topic_prefix_generation() const { return this->topic_prefix_generation_; }
 
   /// Manually set the topic used for logging.
   void set_log_message_template(MQTTMessage &&message);
@@ -214,6 +236,22 @@ class MQTTClientComponent : public Component {
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
 
+  /** Publish a QoS 0 MQTT message through the batch queue.
+   *
+   * The message is queued and sent together with the other queued messages once the batch window has passed. If a
+   * message to the same topic is still queued, only its payload is replaced, so just the latest state is sent.
+   * Without a batch window the message is published right away. Queued messages that fail to publish stay queued
+   * and are retried after the next batch window, until the connection is lost.
+   *
+   * @param topic The topic.
+   * @param payload The payload.
+   * @param retain Whether to retain the message.
+   */
+  bool publish_batched(const std::string &topic, const std::string &payload, bool retain = false);
+
+  /// Set the time messages published with publish_batched() are collected before being sent, 0 to disable batching.
+  void set_publish_batch_window(uint32_t publish_batch_window) { this->publish_batch_window_ = publish_batch_window; }
+
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
   void dump_config() override;
@@ -232,6 +270,9 @@ class MQTTClientComponent : public Component {
 
   void register_mqtt_component(MQTTComponent *component);
 
+  /// Send the scheduled discovery messages and states of the MQTT components in the next loop iterations.
+  void schedule_resend_state() { this->resend_scheduled_ = true; }
+
   bool is_connected();
 
   void on_shutdown() override;
@@ -256,6 +297,14 @@ class MQTTClientComponent : public Component {
   /// Re-calculate the availability property.
   void recalculate_availability_();
 
+  /// Send the messages in the batch queue, the messages that fail to publish stay queued.
+  void flush_publish_queue_();
+
+  /// Send the scheduled discovery messages and states of the MQTT components, within a byte and time budget.
+  void send_scheduled_states_();
+  /// Schedule the discovery messages and states of all components and reset the discovery progress.
+  void start_discovery_pass_();
+
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
@@ -279,10 +328,17 @@ class MQTTClientComponent : public Component {
       .clean = false,
   };
   std::string topic_prefix_{};
+  uint32_t topic_prefix_generation_{0};
   MQTTMessage log_message_;
   std::string payload_buffer_;
   int log_level_{ESPHOME_LOG_LEVEL};
 
+  /// Queued messages, only the first publish_queue_size_ entries are in use so the strings' buffers can be reused.
+  std::vector<MQTTMessage> publish_queue_;
+  size_t publish_queue_size_{0};
+  uint32_t publish_queue_since_{0};
+  uint32_t publish_batch_window_{0};
+
   std::vector<MQTTSubscription> subscriptions_;
   AsyncMqttClient mqtt_client_;
   MQTTClientState state_{MQTT_CLIENT_DISCONNECTED};
@@ -290,6 +346,16 @@ class MQTTClientComponent : public Component {
   bool dns_resolved_{false};
   bool dns_resolve_error_{false};
   std::vector<MQTTComponent *> children_;
+  /// The component send_scheduled_states_() continues with in the next loop iteration.
+  size_t resend_index_{0};
+  bool resend_scheduled_{false};
+  MQTTDiscoveryProgress discovery_progress_{};
+  /// Per component, which of its results were already counted in discovery_progress_.
+  std::vector<uint8_t> discovery_counted_;
+  /// Home Assistant came online, it may have lost the retained discovery messages.
+  bool discovery_resend_requested_{false};
+  /// Total bytes of topics and payloads published, used for the per-loop budget of send_scheduled_states_().
+  uint32_t published_bytes_{0};
   uint32_t reboot_timeout_{300000};
   uint32_t connect_begin_;
   uint32_t last_connected_{0};
@@ -27,119 +27,141 @@ std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) con
          "/" + suffix;
 }
 
-std::string MQTTComponent::get_state_topic_() const {
-  if (this->custom_state_topic_.empty())
-    return this->get_default_topic_for_("state");
-  return this->custom_state_topic_;
+const std::string &MQTTComponent::get_default_topic_cached_(DefaultTopicCache &cache, const char *suffix) const {
+  const uint32_t prefix_generation = global_mqtt_client->get_topic_prefix_generation();
+  const uint32_t object_id_hash = this->get_entity()->get_object_id_hash();
+  if (cache.topic.empty() || cache.prefix_generation != prefix_generation || cache.object_id_hash != object_id_hash) {
+    cache.topic = this->get_default_topic_for_(suffix);
+    cache.prefix_generation = prefix_generation;
+    cache.object_id_hash = object_id_hash;
+  }
+  return cache.topic;
+}
+
+const std::string &MQTTComponent::get_state_topic_() const {
+  if (!this->custom_state_topic_.empty())
+    return this->custom_state_topic_;
+  return this->get_default_topic_cached_(this->default_state_topic_, "state");
 }
 
-std::string MQTTComponent::get_command_topic_() const {
-  if (this->custom_command_topic_.empty())
-    return this->get_default_topic_for_("command");
-  return this->custom_command_topic_;
+const std::string &MQTTComponent::get_command_topic_() const {
+  if (!this->custom_command_topic_.empty())
+    return this->custom_command_topic_;
+  return this->get_default_topic_cached_(this->default_command_topic_, "command");
 }
 
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
   if (topic.empty())
     return false;
-  return global_mqtt_client->publish(topic, payload, 0, this->retain_);
+  return global_mqtt_client->publish_batched(topic, payload, this->retain_);
 }
 
 bool MQTTComponent::publish_json(const std::string &topic, const json::json_build_t &f) {
   if (topic.empty())
     return false;
-  return global_mqtt_client->publish_json(topic, f, 0, this->retain_);
+  return global_mqtt_client->publish_batched(topic, json::build_json(f), this->retain_);
 }
 
-bool MQTTComponent::send_discovery_() {
+MQTTDiscoveryResult MQTTComponent::send_discovery_() {
   const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
 
   if (discovery_info.clean) {
     ESP_LOGV(TAG, "'%s': Cleaning discovery...", this->friendly_name().c_str());
-    return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), "", 0, 0, true);
+    this->discovery_hash_ = 0;
+    if (!global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), "", 0, 0, true))
+      return MQTT_DISCOVERY_FAILED;
+    return MQTT_DISCOVERY_SENT;
   }
 
-  ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
+  const std::string payload = json::build_json([this, &discovery_info](JsonObject root) {
+    SendDiscoveryConfig config;
+    config.state_topic = true;
+    config.command_topic = true;
+
+    this->send_discovery(root, config);
+
+    // Fields from EntityBase
+    root[MQTT_NAME] = this->friendly_name();
+    if (this->is_disabled_by_default())
+      root[MQTT_ENABLED_BY_DEFAULT] = false;
+    if (!this->get_icon().empty())
+      root[MQTT_ICON] = this->get_icon();
+
+    switch (this->get_entity()->get_entity_category()) {
+      case ENTITY_CATEGORY_NONE:
+        break;
+      case ENTITY_CATEGORY_CONFIG:
+        root[MQTT_ENTITY_CATEGORY] = "config";
+        break;
+      case ENTITY_CATEGORY_DIAGNOSTIC:
+        root[MQTT_ENTITY_CATEGORY] = "diagnostic";
+        break;
+    }
+
+    if (config.state_topic)
+      root[MQTT_STATE_TOPIC] = this->get_state_topic_();
+    if (config.command_topic)
+      root[MQTT_COMMAND_TOPIC] = this->get_command_topic_();
+    if (this->command_retain_)
+      root[MQTT_COMMAND_RETAIN] = true;
+
+    if (this->availability_ == nullptr) {
+      if (!global_mqtt_client->get_availability().topic.empty()) {
+        root[MQTT_AVAILABILITY_TOPIC] = global_mqtt_client->get_availability().topic;
+        if (global_mqtt_client->get_availability().payload_available != "online")
+          root[MQTT_PAYLOAD_AVAILABLE] = global_mqtt_client->get_availability().payload_available;
+        if (global_mqtt_client->get_availability().payload_not_available != "offline")
+          root[MQTT_PAYLOAD_NOT_AVAILABLE] = global_mqtt_client->get_availability().payload_not_available;
+      }
+    } else if (!this->availability_->topic.empty()) {
+      root[MQTT_AVAILABILITY_TOPIC] = this->availability_->topic;
+      if (this->availability_->payload_available != "online")
+        root[MQTT_PAYLOAD_AVAILABLE] = this->availability_->payload_available;
+      if (this->availability_->payload_not_available != "offline")
+        root[MQTT_PAYLOAD_NOT_AVAILABLE] = this->availability_->payload_not_available;
+    }
 
-  return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
-      [this](JsonObject root) {
-        SendDiscoveryConfig config;
-        config.state_topic = true;
-        config.command_topic = true;
-
-        this->send_discovery(root, config);
-
-        // Fields from EntityBase
-        root[MQTT_NAME] = this->friendly_name();
-        if (this->is_disabled_by_default())
-          root[MQTT_ENABLED_BY_DEFAULT] = false;
-        if (!this->get_icon().empty())
-          root[MQTT_ICON] = this->get_icon();
-
-        switch (this->get_entity()->get_entity_category()) {
-          case ENTITY_CATEGORY_NONE:
-            break;
-          case ENTITY_CATEGORY_CONFIG:
-            root[MQTT_ENTITY_CATEGORY] = "config";
-            break;
-          case ENTITY_CATEGORY_DIAGNOSTIC:
-            root[MQTT_ENTITY_CATEGORY] = "diagnostic";
-            break;
-        }
-
-        if (config.state_topic)
-          root[MQTT_STATE_TOPIC] = this->get_state_topic_();
-        if (config.command_topic)
-          root[MQTT_COMMAND_TOPIC] = this->get_command_topic_();
-        if (this->command_retain_)
-          root[MQTT_COMMAND_RETAIN] = true;
-
-        if (this->availability_ == nullptr) {
-          if (!global_mqtt_client->get_availability().topic.empty()) {
-            root[MQTT_AVAILABILITY_TOPIC] = global_mqtt_client->get_availability().topic;
-            if (global_mqtt_client->get_availability().payload_available != "online")
-              root[MQTT_PAYLOAD_AVAILABLE] = global_mqtt_client->get_availability().payload_available;
-            if (global_mqtt_client->get_availability().payload_not_available != "offline")
-              root[MQTT_PAYLOAD_NOT_AVAILABLE] = global_mqtt_client->get_availability().payload_not_available;
-          }
-        } else if (!this->availability_->topic.empty()) {
-          root[MQTT_AVAILABILITY_TOPIC] = this->availability_->topic;
-          if (this->availability_->payload_available != "online")
-            root[MQTT_PAYLOAD_AVAILABLE] = this->availability_->payload_available;
-          if (this->availability_->payload_not_available != "offline")
-            root[MQTT_PAYLOAD_NOT_AVAILABLE] = this->availability_->payload_not_available;
-        }
-
-        std::string unique_id = this->unique_id();
-        const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
-        if (!unique_id.empty()) {
-          root[MQTT_UNIQUE_ID] = unique_id;
-        } else {
-          if (discovery_info.unique_id_generator == MQTT_MAC_ADDRESS_UNIQUE_ID_GENERATOR) {
-            char friendly_name_hash[9];
-            sprintf(friendly_name_hash, "%08x", fnv1_hash(this->friendly_name()));
-            friendly_name_hash[8] = 0;  // ensure the hash-string ends with null
-            root[MQTT_UNIQUE_ID] = get_mac_address() + "-" + this->component_type() + "-" + friendly_name_hash;
-          } else {
-            // default to almost-unique ID. It's a hack but the only way to get that
-            // gorgeous device registry view.
-            root[MQTT_UNIQUE_ID] = "ESP" + this->component_type() + this->get_default_object_id_();
-          }
-        }
-
-        const std::string &node_name = App.get_name();
-        if (discovery_info.object_id_generator == MQTT_DEVICE_NAME_OBJECT_ID_GENERATOR)
-          root[MQTT_OBJECT_ID] = node_name + "_" + this->get_default_object_id_();
-
-        JsonObject device_info = root.createNestedObject(MQTT_DEVICE);
-        device_info[MQTT_DEVICE_IDENTIFIERS] = get_mac_address();
-        device_info[MQTT_DEVICE_NAME] = node_name;
-        device_info[MQTT_DEVICE_SW_VERSION] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
-        device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
-        device_info[MQTT_DEVICE_MANUFACTURER] = "espressif";
-      },
-      0, discovery_info.retain);
+    std::string unique_id = this->unique_id();
+    if (!unique_id.empty()) {
+      root[MQTT_UNIQUE_ID] = unique_id;
+    } else {
+      if (discovery_info.unique_id_generator == MQTT_MAC_ADDRESS_UNIQUE_ID_GENERATOR) {
+        char friendly_name_hash[9];
+        sprintf(friendly_name_hash, "%08x", fnv1_hash(this->friendly_name()));
+        friendly_name_hash[8] = 0;  // ensure the hash-string ends with null
+        root[MQTT_UNIQUE_ID] = get_mac_address() + "-" + this->component_type() + "-" + friendly_name_hash;
+      } else {
+        // default to almost-unique ID. It's a hack but the only way to get that
+        // gorgeous device registry view.
+        root[MQTT_UNIQUE_ID] = "ESP" + this->component_type() + this->get_default_object_id_();
+      }
+    }
+
+    const std::string &node_name = App.get_name();
+    if (discovery_info.object_id_generator == MQTT_DEVICE_NAME_OBJECT_ID_GENERATOR)
+      root[MQTT_OBJECT_ID] = node_name + "_" + this->get_default_object_id_();
+
+    JsonObject device_info = root.createNestedObject(MQTT_DEVICE);
+    device_info[MQTT_DEVICE_IDENTIFIERS] = get_mac_address();
+    device_info[MQTT_DEVICE_NAME] = node_name;
+    device_info[MQTT_DEVICE_SW_VERSION] = "esphome v" ESPHOME_VERSION " " + App.get_compilation_time();
+    device_info[MQTT_DEVICE_MODEL] = ESPHOME_BOARD;
+    device_info[MQTT_DEVICE_MANUFACTURER] = "espressif";
+  });
+
+  // Retained discovery messages stay at the broker, so after they were sent once since boot (or since Home Assistant
+  // came online), only publish them again when they changed
+  const uint32_t hash = fnv1_hash(payload);
+  if (discovery_info.retain && hash == this->discovery_hash_) {
+    ESP_LOGV(TAG, "'%s': Discovery unchanged", this->friendly_name().c_str());
+    return MQTT_DISCOVERY_UNCHANGED;
+  }
+
+  ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
+  if (!global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), payload, 0, discovery_info.retain))
+    return MQTT_DISCOVERY_FAILED;
+  this->discovery_hash_ = discovery_info.retain ? hash : 0;
+  return MQTT_DISCOVERY_SENT;
 }
 
 bool MQTTComponent::get_retain() const { return this->retain_; }
@@ -188,17 +210,8 @@ void MQTTComponent::call_setup() {
 
   global_mqtt_client->register_mqtt_component(this);
 
-  if (!this->is_connected_())
-    return;
-
-  if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
-      this->schedule_resend_state();
-    }
-  }
-  if (!this->send_initial_state()) {
+  if (this->is_connected_())
     this->schedule_resend_state();
-  }
 }
 
 void MQTTComponent::call_loop() {
@@ -206,20 +219,22 @@ void MQTTComponent::call_loop() {
     return;
 
   this->loop();
-
-  if (!this->resend_state_ || !this->is_connected_()) {
-    return;
-  }
-
+}
+MQTTDiscoveryResult MQTTComponent::send_scheduled_state() {
   this->resend_state_ = false;
+  MQTTDiscoveryResult result = MQTT_DISCOVERY_DISABLED;
   if (this->is_discovery_enabled()) {
-    if (!this->send_discovery_()) {
+    result = this->send_discovery_();
+    if (result == MQTT_DISCOVERY_FAILED) {
+      // Don't send the state before Home Assistant knows about this entity
       this->schedule_resend_state();
+      return result;
     }
   }
   if (!this->send_initial_state()) {
     this->schedule_resend_state();
   }
+  return result;
 }
 void MQTTComponent::call_dump_config() {
   if (this->is_internal())
@@ -227,7 +242,10 @@ void MQTTComponent::call_dump_config() {
 
   this->dump_config();
 }
-void MQTTComponent::schedule_resend_state() { this->resend_state_ = true; }
+void MQTTComponent::schedule_resend_state() {
+  this->resend_state_ = true;
+  global_mqtt_client->schedule_resend_state();
+}
 std::string MQTTComponent::unique_id() { return ""; }
 bool MQTTComponent::is_connected_() const { return global_mqtt_client->is_connected(); }
 
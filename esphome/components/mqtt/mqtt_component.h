@@ -30,17 +30,27 @@ struct SendDiscoveryConfig {
 #define MQTT_COMPONENT_CUSTOM_TOPIC_(name, type) \
  protected: \
   std::string custom_##name##_##type##_topic_{}; \
+  mutable DefaultTopicCache default_##name##_##type##_topic_{}; \
 \
  public: \
   void set_custom_##name##_##type##_topic(const std::string &topic) { this->custom_##name##_##type##_topic_ = topic; } \
-  std::string get_##name##_##type##_topic() const { \
-    if (this->custom_##name##_##type##_topic_.empty()) \
-      return this->get_default_topic_for_(#name "/" #type); \
-    return this->custom_##name##_##type##_topic_; \
+  const std::string &get_##name##_##type##_topic() const { \
+    if (!this->custom_##name##_##type##_topic_.empty()) \
+      return this->custom_##name##_##type##_topic_; \
+    return this->get_default_topic_cached_(this->default_##name##_##type##_topic_, #name "/" #type); \
   }
 
 #define MQTT_COMPONENT_CUSTOM_TOPIC(name, type) MQTT_COMPONENT_CUSTOM_TOPIC_(name, type)
 
+/// A default topic of a component, built on first use and rebuilt when the topic prefix or the entity's name changes.
+struct DefaultTopicCache {
+  /// The topic, empty if it wasn't built yet.
+  std::string topic;
+  /// The topic prefix generation and object id hash the topic was built with.
+  uint32_t prefix_generation;
+  uint32_t object_id_hash;
+};
+
 /** MQTTComponent is the base class for all components that interact with MQTT to expose
  * certain functionality or data from actuators or sensors to clients.
  *
@@ -106,8 +116,19 @@ class MQTTComponent : public Component {
 
   /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
   void schedule_resend_state();
+  bool is_resend_scheduled() const { return this->resend_state_; }
+  /// Forget which discovery message was retained, so the next one is sent even if it didn't change.
+  void clear_discovery_hash() { this->discovery_hash_ = 0; }
+  /** Internal method for the MQTT client base to send the discovery message and state after a scheduled resend.
+   *
+   * The client calls this for a limited number of components per loop iteration, so that connecting doesn't publish
+   * the discovery messages of all components at once.
+   */
+  MQTTDiscoveryResult send_scheduled_state();
 
   /** Send a MQTT message.
+   *
+   * Messages to the same topic may be coalesced, see MQTTClientComponent::publish_batched().
    *
    * @param topic The topic.
    * @param payload The payload.
@@ -150,6 +171,8 @@ class MQTTComponent : public Component {
    * @return The full topic.
    */
   std::string get_default_topic_for_(const std::string &suffix) const;
+  /// Get the default topic for suffix from cache, it's rebuilt when the topic prefix or the entity's name changed.
+  const std::string &get_default_topic_cached_(DefaultTopicCache &cache, const char *suffix) const;
 
   /**
    * Gets the Entity served by this MQTT component.
@@ -172,29 +195,34 @@ class MQTTComponent : public Component {
   /// Get whether the underlying Entity is disabled by default
   virtual bool is_disabled_by_default() const;
 
-  /// Get the MQTT topic that new states will be shared to.
-  std::string get_state_topic_() const;
+  /// Get the MQTT topic that new states will be shared to, the custom topic or the cached default topic.
+  const std::string &get_state_topic_() const;
 
-  /// Get the MQTT topic for listening to commands.
-  std::string get_command_topic_() const;
+  /// Get the MQTT topic for listening to commands, the custom topic or the cached default topic.
+  const std::string &get_command_topic_() const;
 
   bool is_connected_() const;
 
   /// Internal method to start sending discovery info, this will call send_discovery().
-  bool send_discovery_();
+  MQTTDiscoveryResult send_discovery_();
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Generate the Home Assistant MQTT discovery object id by automatically transforming the friendly name.
   std::string get_default_object_id_() const;
 
+  /// The topics set by the user, empty to use the default topics.
   std::string custom_state_topic_{};
   std::string custom_command_topic_{};
+  mutable DefaultTopicCache default_state_topic_{};
+  mutable DefaultTopicCache default_command_topic_{};
   bool command_retain_{false};
   bool retain_{true};
   bool discovery_enabled_{true};
   std::unique_ptr<Availability> availability_;
   bool resend_state_{false};
+  /// Hash of the last discovery message that was published with retain, 0 if none.
+  uint32_t discovery_hash_{0};
 };
 
 }  // namespace mqtt
@@ -2,6 +2,7 @@
 #include "esphome/core/util.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
 
 namespace esphome {
 namespace nextion {
@@ -30,14 +31,66 @@ bool Nextion::send_command_(const std::string &command) {
     return false;
   }
 
+  // Keep the order of commands, except for updates that can't be sent while sleeping
+  if (!this->is_sleeping())
+    this->send_pending_updates_(true);
+  // Components show their initial values again on a new page
+  if (command.compare(0, 5, "page ") == 0)
+    this->sent_commands_.clear();
+
   ESP_LOGN(TAG, "send_command %s", command.c_str());
 
-  this->write_str(command.c_str());
-  const uint8_t to_send[3] = {0xFF, 0xFF, 0xFF};
-  this->write_array(to_send, sizeof(to_send));
+  std::string to_send;
+  to_send.reserve(command.size() + COMMAND_DELIMITER.size());
+  to_send += command;
+  to_send += COMMAND_DELIMITER;
+  this->write_array(reinterpret_cast<const uint8_t *>(to_send.data()), to_send.size());
   return true;
 }
 
+void Nextion::queue_component_update_(const std::string &variable_name, const std::string &variable_name_to_send,
+                                      std::string &&command) {
+  auto sent = this->sent_commands_.find(variable_name_to_send);
+  bool is_shown = sent != this->sent_commands_.end() && sent->second == command;
+
+  for (auto it = this->pending_updates_.begin(); it != this->pending_updates_.end(); ++it) {
+    if (it->variable_name_to_send != variable_name_to_send)
+      continue;
+    ESP_LOGN(TAG, "Replacing pending update %s", it->command.c_str());
+    if (is_shown) {
+      this->pending_updates_.erase(it);
+    } else {
+      it->command = std::move(command);
+    }
+    return;
+  }
+
+  if (is_shown) {
+    ESP_LOGN(TAG, "Skipping unchanged update %s", command.c_str());
+    return;
+  }
+  this->pending_updates_.push_back(PendingUpdate{variable_name, variable_name_to_send, std::move(command)});
+}
+
+void Nextion::send_pending_updates_(bool ignore_window) {
+  std::string to_send;
+  size_t count = 0;
+  for (auto &update : this->pending_updates_) {
+    if (!ignore_window && this->nextion_queue_.size() >= MAX_IN_FLIGHT_COMMANDS)
+      break;
+    ESP_LOGN(TAG, "send_command %s", update.command.c_str());
+    to_send += update.command;
+    to_send += COMMAND_DELIMITER;
+    this->sent_commands_[update.variable_name_to_send] = std::move(update.command);
+    this->add_no_result_to_queue_(update.variable_name);
+    count++;
+  }
+  if (count == 0)
+    return;
+  this->write_array(reinterpret_cast<const uint8_t *>(to_send.data()), to_send.size());
+  this->pending_updates_.erase(this->pending_updates_.begin(), this->pending_updates_.begin() + count);
+}
+
 bool Nextion::check_connect_() {
   if (this->get_is_connected_())
     return true;
@@ -111,6 +164,8 @@ void Nextion::reset_(bool reset_nextion) {
     this->read_byte(&d);
   };
   this->nextion_queue_.clear();
+  this->pending_updates_.clear();
+  this->sent_commands_.clear();
 }
 
 void Nextion::dump_config() {
@@ -238,6 +293,8 @@ void Nextion::loop() {
 
   this->process_serial_();            // Receive serial data
   this->process_nextion_commands_();  // Process nextion return commands
+  if (!this->is_sleeping())
+    this->send_pending_updates_(false);
 
   if (!this->nextion_reports_is_setup_) {
     if (this->started_ms_ == 0)
@@ -433,6 +490,8 @@ void Nextion::process_nextion_commands_() {
         uint8_t touch_event = to_process[2];  // 0 -> release, 1 -> press
         ESP_LOGD(TAG, "Got touch page=%u component=%u type=%s", page_id, component_id,
                  touch_event ? "PRESS" : "RELEASE");
+        // The touch may have changed the page or a component
+        this->sent_commands_.clear();
         for (auto *touch : this->touch_) {
           touch->process_touch(page_id, component_id, touch_event != 0);
         }
@@ -456,6 +515,7 @@ void Nextion::process_nextion_commands_() {
         break;
       }
       case 0x66: {
+        this->sent_commands_.clear();
         break;
       }  // sendme page id
 
@@ -544,6 +604,7 @@ void Nextion::process_nextion_commands_() {
       {
         ESP_LOGVV(TAG, "Received Nextion leaves sleep automatically");
         this->is_sleeping_ = false;
+        this->sent_commands_.clear();
         this->wake_callback_.call();
         this->all_components_send_state_(false);
         break;
@@ -552,6 +613,7 @@ void Nextion::process_nextion_commands_() {
       {
         ESP_LOGD(TAG, "system successful start up %zu", to_process_length);
         this->nextion_reports_is_setup_ = true;
+        this->sent_commands_.clear();
         break;
       }
       case 0x89: {  // start SD card upgrade
@@ -1000,7 +1062,11 @@ void Nextion::add_no_result_to_queue_with_set(NextionComponentBase *component, i
 
 void Nextion::add_no_result_to_queue_with_set(const std::string &variable_name,
                                               const std::string &variable_name_to_send, int state_value) {
-  this->add_no_result_to_queue_with_set_internal_(variable_name, variable_name_to_send, state_value);
+  if ((!this->is_setup() && !this->ignore_is_setup_) || this->is_sleeping())
+    return;
+
+  this->queue_component_update_(variable_name, variable_name_to_send,
+                                variable_name_to_send + "=" + to_string(state_value));
 }
 
 void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &variable_name,
@@ -1028,7 +1094,16 @@ void Nextion::add_no_result_to_queue_with_set(NextionComponentBase *component, c
 void Nextion::add_no_result_to_queue_with_set(const std::string &variable_name,
                                               const std::string &variable_name_to_send,
                                               const std::string &state_value) {
-  this->add_no_result_to_queue_with_set_internal_(variable_name, variable_name_to_send, state_value);
+  if ((!this->is_setup() && !this->ignore_is_setup_) || this->is_sleeping())
+    return;
+
+  std::string command;
+  command.reserve(variable_name_to_send.size() + state_value.size() + 3);
+  command += variable_name_to_send;
+  command += "=\"";
+  command += state_value;
+  command += '"';
+  this->queue_component_update_(variable_name, variable_name_to_send, std::move(command));
 }
 
 void Nextion::add_no_result_to_queue_with_set_internal_(const std::string &variable_name,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <deque>
+#include <map>
 #include "esphome/core/defines.h"
 #include "esphome/components/uart/uart.h"
 #include "nextion_base.h"
@@ -31,6 +32,9 @@ using nextion_writer_t = std::function<void(Nextion &)>;
 
 static const std::string COMMAND_DELIMITER{static_cast<char>(255), static_cast<char>(255), static_cast<char>(255)};
 
+/// Maximum number of commands waiting for a reply before component updates are held back.
+static const size_t MAX_IN_FLIGHT_COMMANDS = 8;
+
 class Nextion : public NextionBase, public PollingComponent, public uart::UARTDevice {
  public:
   /**
@@ -769,6 +773,26 @@ class Nextion : public NextionBase, public PollingComponent, public uart::UARTDe
                                                  const std::string &variable_name_to_send,
                                                  const std::string &state_value, bool is_sleep_safe = false);
 
+  /** Queue a command that sets the value of a component.
+   *
+   * A pending update of the same component is replaced, and the update is dropped when the component already shows
+   * this value. Pending updates are sent from loop() in a single write, as long as fewer than MAX_IN_FLIGHT_COMMANDS
+   * commands wait for a reply.
+   */
+  void queue_component_update_(const std::string &variable_name, const std::string &variable_name_to_send,
+                               std::string &&command);
+  /// Send pending component updates, limited by the in-flight window unless ignore_window is set.
+  void send_pending_updates_(bool ignore_window);
+
+  struct PendingUpdate {
+    std::string variable_name;
+    std::string variable_name_to_send;
+    std::string command;
+  };
+  std::vector<PendingUpdate> pending_updates_;
+  /// Last command sent to each component, cleared whenever the display may have changed them itself.
+  std::map<std::string, std::string> sent_commands_;
+
 #ifdef USE_NEXTION_TFT_UPLOAD
 #ifdef USE_ESP8266
   WiFiClient *wifi_client_{nullptr};
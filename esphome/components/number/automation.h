@@ -55,6 +55,10 @@ template<typename... Ts> class NumberInRangeCondition : public Condition<Ts...>
 
   void set_min(float min) { this->min_ = min; }
   void set_max(float max) { this->max_ = max; }
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    this->parent_->add_on_state_callback([callback](float state) { callback(); });
+    return true;
+  }
   bool check(Ts... x) override {
     const float state = this->parent_->state;
     if (std::isnan(this->min_)) {
@@ -13,6 +13,13 @@ class OTABackend {
   virtual OTAResponseTypes end() = 0;
   virtual void abort() = 0;
   virtual bool supports_compression() = 0;
+  /// Whether delta updates can be offered. Must be cheap, it's called before the client is authenticated.
+  virtual bool supports_delta() { return false; }
+  /// Size of the firmware image that is currently running, delta updates are applied to it. 0 if it can't be read.
+  /// May read the whole image, so only call it after authentication.
+  virtual size_t get_running_image_size() { return 0; }
+  /// Read part of the running firmware image.
+  virtual bool read_running_image(size_t offset, uint8_t *data, size_t len) { return false; }
 };
 
 }  // namespace ota
@@ -6,6 +6,8 @@
 #include "ota_backend.h"
 
 #include <Update.h>
+#include <esp_ota_ops.h>
+#include <esp_image_format.h>
 
 namespace esphome {
 namespace ota {
@@ -40,6 +42,25 @@ OTAResponseTypes ArduinoESP32OTABackend::end() {
 
 void ArduinoESP32OTABackend::abort() { Update.abort(); }
 
+bool ArduinoESP32OTABackend::supports_delta() { return esp_ota_get_running_partition() != nullptr; }
+
+// Verifying the image reads all of it, but it's the only way to get its length including the appended checksum
+size_t ArduinoESP32OTABackend::get_running_image_size() {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  if (running == nullptr)
+    return 0;
+  esp_partition_pos_t pos{running->address, running->size};
+  esp_image_metadata_t metadata{};
+  if (esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &pos, &metadata) != ESP_OK)
+    return 0;
+  return metadata.image_len;
+}
+
+bool ArduinoESP32OTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  return running != nullptr && esp_partition_read(running, offset, data, len) == ESP_OK;
+}
+
 }  // namespace ota
 }  // namespace esphome
 
@@ -52,6 +52,15 @@ void ArduinoESP8266OTABackend::abort() {
   esp8266::preferences_prevent_write(false);
 }
 
+// The sketch starts at the beginning of the flash, after the bootloader, and getSketchSize() returns where it ends
+bool ArduinoESP8266OTABackend::supports_delta() { return true; }
+
+size_t ArduinoESP8266OTABackend::get_running_image_size() { return ESP.getSketchSize(); }
+
+bool ArduinoESP8266OTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  return ESP.flashRead(offset, data, len);
+}
+
 }  // namespace ota
 }  // namespace esphome
 
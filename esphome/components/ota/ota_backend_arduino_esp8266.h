@@ -17,6 +17,9 @@ class ArduinoESP8266OTABackend : public OTABackend {
   OTAResponseTypes write(uint8_t *data, size_t len) override;
   OTAResponseTypes end() override;
   void abort() override;
+  bool supports_delta() override;
+  size_t get_running_image_size() override;
+  bool read_running_image(size_t offset, uint8_t *data, size_t len) override;
 #if USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 7, 0)
   bool supports_compression() override { return true; }
 #else
@@ -4,6 +4,7 @@
 #include "ota_backend_esp_idf.h"
 #include "ota_component.h"
 #include <esp_ota_ops.h>
+#include <esp_image_format.h>
 #include "esphome/components/md5/md5.h"
 
 namespace esphome {
@@ -73,6 +74,25 @@ void IDFOTABackend::abort() {
   this->update_handle_ = 0;
 }
 
+bool IDFOTABackend::supports_delta() { return esp_ota_get_running_partition() != nullptr; }
+
+// Verifying the image reads all of it, but it's the only way to get its length including the appended checksum
+size_t IDFOTABackend::get_running_image_size() {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  if (running == nullptr)
+    return 0;
+  esp_partition_pos_t pos{running->address, running->size};
+  esp_image_metadata_t metadata{};
+  if (esp_image_verify(ESP_IMAGE_VERIFY_SILENT, &pos, &metadata) != ESP_OK)
+    return 0;
+  return metadata.image_len;
+}
+
+bool IDFOTABackend::read_running_image(size_t offset, uint8_t *data, size_t len) {
+  const esp_partition_t *running = esp_ota_get_running_partition();
+  return running != nullptr && esp_partition_read(running, offset, data, len) == ESP_OK;
+}
+
 }  // namespace ota
 }  // namespace esphome
 #endif
@@ -0,0 +1,145 @@
+#include "ota_block_writer.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+#ifdef USE_ESP32
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace ota {
+
+OTABlockWriter::~OTABlockWriter() {
+#ifdef USE_ESP32
+  // Make sure the task is done with the blocks and the backend
+  if (this->running_)
+    this->finish();
+  if (this->free_queue_ != nullptr)
+    vQueueDelete(this->free_queue_);
+  if (this->full_queue_ != nullptr)
+    vQueueDelete(this->full_queue_);
+  if (this->done_ != nullptr)
+    vSemaphoreDelete(this->done_);
+#endif
+  delete[] this->blocks_;  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+bool OTABlockWriter::start() {
+  this->blocks_ = new (std::nothrow) uint8_t[OTA_BLOCK_SIZE * OTA_BLOCK_COUNT];  // NOLINT
+  if (this->blocks_ == nullptr)
+    return false;
+
+#ifdef USE_ESP32
+  this->free_queue_ = xQueueCreate(OTA_BLOCK_COUNT, sizeof(uint8_t *));
+  // One more entry than there are blocks, so the end marker sent by finish() always fits
+  this->full_queue_ = xQueueCreate(OTA_BLOCK_COUNT + 1, sizeof(Block));
+  this->done_ = xSemaphoreCreateBinary();
+  if (this->free_queue_ == nullptr || this->full_queue_ == nullptr || this->done_ == nullptr)
+    return false;
+
+  for (size_t i = 0; i < OTA_BLOCK_COUNT; i++) {
+    uint8_t *block = this->blocks_ + i * OTA_BLOCK_SIZE;
+    xQueueSend(this->free_queue_, &block, 0);
+  }
+  if (xTaskCreate(OTABlockWriter::write_task, "ota_write", 4096, this, uxTaskPriorityGet(nullptr), nullptr) != pdPASS)
+    return false;
+  this->running_ = true;
+#endif
+  return true;
+}
+
+uint8_t *OTABlockWriter::get_block() {
+  if (this->error_ != OTA_RESPONSE_OK)
+    return nullptr;
+#ifdef USE_ESP32
+  uint32_t start = millis();
+  while (xQueueReceive(this->free_queue_, &this->current_, 10 / portTICK_PERIOD_MS) != pdTRUE)
+    App.feed_wdt();
+  this->stall_time_ += millis() - start;
+  if (this->error_ != OTA_RESPONSE_OK) {
+    xQueueSend(this->free_queue_, &this->current_, 0);
+    this->current_ = nullptr;
+  }
+  return this->current_;
+#else
+  return this->blocks_;
+#endif
+}
+
+void OTABlockWriter::submit(size_t len) {
+#ifdef USE_ESP32
+  Block block{this->current_, len};
+  xQueueSend(this->full_queue_, &block, portMAX_DELAY);
+  this->current_ = nullptr;
+#else
+  uint32_t start = millis();
+  OTAResponseTypes error = this->backend_->write(this->blocks_, len);
+  this->stall_time_ += millis() - start;
+  if (error != OTA_RESPONSE_OK)
+    this->error_ = error;
+#endif
+}
+
+bool OTABlockWriter::write(const uint8_t *data, size_t len) {
+  while (len != 0) {
+    if (this->fill_block_ == nullptr) {
+      this->fill_block_ = this->get_block();
+      this->fill_len_ = 0;
+      if (this->fill_block_ == nullptr)
+        return false;
+    }
+    size_t chunk = std::min(len, OTA_BLOCK_SIZE - this->fill_len_);
+    memcpy(this->fill_block_ + this->fill_len_, data, chunk);
+    this->fill_len_ += chunk;
+    data += chunk;
+    len -= chunk;
+    if (this->fill_len_ == OTA_BLOCK_SIZE) {
+      this->submit(this->fill_len_);
+      this->fill_block_ = nullptr;
+    }
+  }
+  return true;
+}
+
+OTAResponseTypes OTABlockWriter::finish() {
+  // write() only keeps a block while it holds data
+  if (this->fill_block_ != nullptr) {
+    this->submit(this->fill_len_);
+    this->fill_block_ = nullptr;
+  }
+#ifdef USE_ESP32
+  if (this->running_) {
+    Block end{nullptr, 0};
+    xQueueSend(this->full_queue_, &end, portMAX_DELAY);
+    while (xSemaphoreTake(this->done_, 10 / portTICK_PERIOD_MS) != pdTRUE)
+      App.feed_wdt();
+    this->running_ = false;
+  }
+#endif
+  return this->error_;
+}
+
+#ifdef USE_ESP32
+void OTABlockWriter::write_task(void *param) {
+  auto *writer = static_cast<OTABlockWriter *>(param);
+  Block block;
+  while (xQueueReceive(writer->full_queue_, &block, portMAX_DELAY) == pdTRUE && block.data != nullptr) {
+    // Keep returning blocks after an error so get_block() doesn't wait forever
+    if (writer->error_ == OTA_RESPONSE_OK) {
+      OTAResponseTypes error = writer->backend_->write(block.data, block.len);
+      if (error != OTA_RESPONSE_OK)
+        writer->error_ = error;
+    }
+    xQueueSend(writer->free_queue_, &block.data, portMAX_DELAY);
+  }
+  xSemaphoreGive(writer->done_);
+  vTaskDelete(nullptr);
+}
+#endif
+
+}  // namespace ota
+}  // namespace esphome
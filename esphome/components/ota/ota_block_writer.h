@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "ota_backend.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#endif
+
+namespace esphome {
+namespace ota {
+
+#ifdef USE_ESP32
+/// Size of a block, one flash sector.
+static const size_t OTA_BLOCK_SIZE = 4096;
+/// Number of blocks, one is received while the others wait for or are being written to flash.
+static const size_t OTA_BLOCK_COUNT = 2;
+#else
+static const size_t OTA_BLOCK_SIZE = 1024;
+static const size_t OTA_BLOCK_COUNT = 1;
+#endif
+
+/** Writes the received OTA image to an OTABackend in blocks.
+ *
+ * On the ESP32 the blocks are hashed and written to flash by a separate task, so the next block can be received from
+ * the socket in the meantime. Elsewhere each block is written as soon as it's submitted.
+ *
+ * Data is either copied in with write(), or received directly into a block: get_block() returns a buffer of
+ * OTA_BLOCK_SIZE bytes and submit() hands it over to be written. finish() waits until everything has been written.
+ */
+class OTABlockWriter {
+ public:
+  explicit OTABlockWriter(OTABackend *backend) : backend_(backend) {}
+  ~OTABlockWriter();
+
+  /// Allocate the blocks and start the writer task, returns false if that failed.
+  bool start();
+  /// Get a free block to receive into, waiting for one to be written if needed. Returns nullptr after a write error.
+  uint8_t *get_block();
+  /// Write the first len bytes of the block returned by the last get_block() call.
+  void submit(size_t len);
+  /// Copy data into blocks, submitting each one once it's full. Returns false after a write error.
+  bool write(const uint8_t *data, size_t len);
+  /// Wait until all data is written and return the result of the first failed write, if any.
+  OTAResponseTypes finish();
+
+  OTAResponseTypes get_error() const { return this->error_; }
+  /// Time in milliseconds get_block() had to wait for the flash.
+  uint32_t get_stall_time() const { return this->stall_time_; }
+
+ protected:
+  uint8_t *blocks_{nullptr};
+  OTABackend *backend_;
+  volatile OTAResponseTypes error_{OTA_RESPONSE_OK};
+  uint32_t stall_time_{0};
+  /// The block write() copies into, and how much of it is filled.
+  uint8_t *fill_block_{nullptr};
+  size_t fill_len_{0};
+#ifdef USE_ESP32
+  struct Block {
+    uint8_t *data;
+    size_t len;
+  };
+
+  static void write_task(void *param);
+
+  QueueHandle_t free_queue_{nullptr};
+  QueueHandle_t full_queue_{nullptr};
+  SemaphoreHandle_t done_{nullptr};
+  bool running_{false};
+  uint8_t *current_{nullptr};
+#endif
+};
+
+}  // namespace ota
+}  // namespace esphome
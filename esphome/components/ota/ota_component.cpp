@@ -3,6 +3,8 @@
 #include "ota_backend_arduino_esp32.h"
 #include "ota_backend_arduino_esp8266.h"
 #include "ota_backend_esp_idf.h"
+#include "ota_block_writer.h"
+#include "ota_delta.h"
 
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
@@ -13,6 +15,7 @@
 
 #include <cerrno>
 #include <cstdio>
+#include <cstring>
 
 namespace esphome {
 namespace ota {
@@ -108,6 +111,29 @@ void OTAComponent::loop() {
 }
 
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
+static const uint8_t FEATURE_SUPPORTS_DELTA = 0x02;
+
+static const uint8_t OTA_MODE_FULL = 0;
+static const uint8_t OTA_MODE_DELTA = 1;
+/// Sent instead of an update mode when the client has a cached base image, to request the MD5 of the running image.
+static const uint8_t OTA_MODE_QUERY_BASE = 2;
+
+/// Calculate the MD5 of the running image as 32 hex characters, so the client can tell which image it has to patch.
+static bool running_image_md5(OTABackend *backend, size_t size, char *md5_hex) {
+  md5::MD5Digest md5{};
+  md5.init();
+  uint8_t buf[256];
+  for (size_t offset = 0; offset < size; offset += sizeof(buf)) {
+    size_t len = std::min(size - offset, sizeof(buf));
+    if (!backend->read_running_image(offset, buf, len))
+      return false;
+    md5.add(buf, len);
+    App.feed_wdt();
+  }
+  md5.calculate();
+  md5.get_hex(md5_hex);
+  return true;
+}
 
 void OTAComponent::handle_() {
   OTAResponseTypes error_code = OTA_RESPONSE_ERROR_UNKNOWN;
@@ -119,6 +145,13 @@ void OTAComponent::handle_() {
   size_t ota_size;
   uint8_t ota_features;
   std::unique_ptr<OTABackend> backend;
+  std::unique_ptr<OTABlockWriter> writer;
+  std::unique_ptr<OTADeltaDecoder> delta;
+  size_t base_size = 0;
+  bool delta_offered = false;
+  uint32_t receive_start;
+  uint32_t receive_time;
+  uint32_t network_wait;
   (void) ota_features;
 
   if (client_ == nullptr) {
@@ -175,7 +208,15 @@ void OTAComponent::handle_() {
     buf[0] = OTA_RESPONSE_SUPPORTS_COMPRESSION;
   }
 
-  this->writeall_(buf, 1);
+  delta_offered = (ota_features & FEATURE_SUPPORTS_DELTA) != 0 && backend->supports_delta();
+  if (delta_offered) {
+    // Offer a delta update: delta response and header acknowledgement - 2 bytes
+    buf[1] = buf[0];
+    buf[0] = OTA_RESPONSE_SUPPORTS_DELTA;
+    this->writeall_(buf, 2);
+  } else {
+    this->writeall_(buf, 1);
+  }
 
 #ifdef USE_OTA_PASSWORD
   if (!this->password_.empty()) {
@@ -240,6 +281,44 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_AUTH_OK;
   this->writeall_(buf, 1);
 
+  if (delta_offered) {
+    // Read update mode - 1 byte
+    if (!this->readall_(buf, 1)) {
+      ESP_LOGW(TAG, "Reading update mode failed!");
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    if (buf[0] == OTA_MODE_QUERY_BASE) {
+      // The client has a cached image, send the MD5 of the running image (32 bytes hex) so it can tell if it's
+      // the same. Only done after authentication, as it reads the whole image from flash.
+      base_size = backend->get_running_image_size();
+      if (base_size == 0 || !running_image_md5(backend.get(), base_size, sbuf)) {
+        // Matches no cached image, so the client falls back to a full update
+        memset(buf, '0', 32);
+      }
+      ESP_LOGV(TAG, "Running image MD5 is %.32s", sbuf);
+      this->writeall_(buf, 32);
+
+      // Read update mode - 1 byte
+      if (!this->readall_(buf, 1)) {
+        ESP_LOGW(TAG, "Reading update mode failed!");
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+    }
+    if (buf[0] != OTA_MODE_FULL && buf[0] != OTA_MODE_DELTA) {
+      ESP_LOGW(TAG, "Unknown update mode %u", buf[0]);
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
+    if (buf[0] != OTA_MODE_DELTA) {
+      base_size = 0;
+    } else if (base_size == 0) {
+      base_size = backend->get_running_image_size();
+      if (base_size == 0) {
+        ESP_LOGW(TAG, "Can't read the running image to apply a delta update to!");
+        goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+      }
+    }
+  }
+
   // Read size, 4 bytes MSB first
   if (!this->readall_(buf, 4)) {
     ESP_LOGW(TAG, "Reading size failed!");
@@ -274,14 +353,31 @@ void OTAComponent::handle_() {
   buf[0] = OTA_RESPONSE_BIN_MD5_OK;
   this->writeall_(buf, 1);
 
-  while (total < ota_size) {
+  writer = make_unique<OTABlockWriter>(backend.get());
+  if (!writer->start()) {
+    ESP_LOGW(TAG, "Allocating OTA buffers failed!");
+    error_code = OTA_RESPONSE_ERROR_UNKNOWN;
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+
+  if (base_size != 0) {
+    ESP_LOGD(TAG, "Applying delta update to the running image of %u bytes", base_size);
+    delta = make_unique<OTADeltaDecoder>(backend.get(), base_size, writer.get());
+  }
+
+  // The received data is written to flash while the next part is received (on the ESP32)
+  receive_start = millis();
+  network_wait = 0;
+  while (delta != nullptr ? !delta->is_done() : total < ota_size) {
     // TODO: timeout check
-    size_t requested = std::min(sizeof(buf), ota_size - total);
+    // A delta patch ends itself, so only a full image limits how much is read
+    size_t requested = delta != nullptr ? sizeof(buf) : std::min(sizeof(buf), ota_size - total);
     ssize_t read = this->client_->read(buf, requested);
     if (read == -1) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
         App.feed_wdt();
         delay(1);
+        network_wait++;
         continue;
       }
       ESP_LOGW(TAG, "Error receiving data for update, errno: %d", errno);
@@ -294,12 +390,22 @@ void OTAComponent::handle_() {
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
 
-    error_code = backend->write(buf, read);
+    if (delta != nullptr) {
+      error_code = delta->feed(buf, read);
+      total = delta->get_output_size();
+    } else {
+      error_code = writer->write(buf, read) ? OTA_RESPONSE_OK : writer->get_error();
+      total += read;
+    }
     if (error_code != OTA_RESPONSE_OK) {
       ESP_LOGW(TAG, "Error writing binary data to flash!");
       goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
     }
-    total += read;
+    if (total > ota_size) {
+      ESP_LOGW(TAG, "Delta update is larger than the new image!");
+      error_code = OTA_RESPONSE_ERROR_INVALID_DELTA;
+      goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+    }
 
     uint32_t now = millis();
     if (now - last_progress > 1000) {
@@ -315,6 +421,21 @@ void OTAComponent::handle_() {
     }
   }
 
+  error_code = writer->finish();
+  if (error_code != OTA_RESPONSE_OK) {
+    ESP_LOGW(TAG, "Error writing binary data to flash!");
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+  if (total != ota_size) {
+    ESP_LOGW(TAG, "Delta update is smaller than the new image!");
+    error_code = OTA_RESPONSE_ERROR_INVALID_DELTA;
+    goto error;  // NOLINT(cppcoreguidelines-avoid-goto)
+  }
+  receive_time = std::max<uint32_t>(millis() - receive_start, 1);
+  ESP_LOGD(TAG, "Received %u bytes in %u ms (%u kB/s), waited %u ms for data and %u ms for flash writes", total,
+           receive_time, total / receive_time, network_wait, writer->get_stall_time());
+  writer.reset();
+
   // Acknowledge receive OK - 1 byte
   buf[0] = OTA_RESPONSE_RECEIVE_OK;
   this->writeall_(buf, 1);
@@ -352,6 +473,8 @@ error:
   this->client_->close();
   this->client_ = nullptr;
 
+  // Waits for pending writes, so the backend isn't aborted while in use
+  writer.reset();
   if (backend != nullptr && update_started) {
     backend->abort();
   }
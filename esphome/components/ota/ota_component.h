@@ -20,6 +20,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_RECEIVE_OK = 68,
   OTA_RESPONSE_UPDATE_END_OK = 69,
   OTA_RESPONSE_SUPPORTS_COMPRESSION = 70,
+  OTA_RESPONSE_SUPPORTS_DELTA = 71,
 
   OTA_RESPONSE_ERROR_MAGIC = 128,
   OTA_RESPONSE_ERROR_UPDATE_PREPARE = 129,
@@ -32,6 +33,7 @@ enum OTAResponseTypes {
   OTA_RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136,
   OTA_RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137,
   OTA_RESPONSE_ERROR_NO_UPDATE_PARTITION = 138,
+  OTA_RESPONSE_ERROR_INVALID_DELTA = 139,
   OTA_RESPONSE_ERROR_UNKNOWN = 255,
 };
 
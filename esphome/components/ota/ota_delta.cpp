@@ -0,0 +1,130 @@
+#include "ota_delta.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace ota {
+
+static const char *const TAG = "ota.delta";
+
+static const uint8_t DELTA_MAGIC[4] = {'E', 'D', 'L', '1'};
+static const uint8_t DELTA_OP_END = 0x00;
+static const uint8_t DELTA_OP_COPY = 0x01;
+static const uint8_t DELTA_OP_DATA = 0x02;
+
+static uint32_t decode_uint32(const uint8_t *data) {
+  return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | data[3];
+}
+
+OTAResponseTypes OTADeltaDecoder::feed(const uint8_t *data, size_t len) {
+  while (len != 0) {
+    if (this->state_ == STATE_DONE) {
+      ESP_LOGW(TAG, "Data after the end of the patch");
+      return OTA_RESPONSE_ERROR_INVALID_DELTA;
+    }
+
+    if (this->state_ == STATE_DATA) {
+      size_t chunk = std::min<size_t>(len, this->remaining_);
+      if (!this->writer_->write(data, chunk))
+        return this->writer_->get_error();
+      this->output_size_ += chunk;
+      this->remaining_ -= chunk;
+      data += chunk;
+      len -= chunk;
+      if (this->remaining_ == 0)
+        this->state_ = STATE_OPCODE;
+      continue;
+    }
+
+    // Collect the fixed size part of the current element, it may be split over several reads
+    size_t chunk = std::min(len, this->header_size_() - this->header_len_);
+    memcpy(this->header_ + this->header_len_, data, chunk);
+    this->header_len_ += chunk;
+    data += chunk;
+    len -= chunk;
+    if (this->header_len_ < this->header_size_())
+      break;
+    this->header_len_ = 0;
+    OTAResponseTypes error = this->process_header_();
+    if (error != OTA_RESPONSE_OK)
+      return error;
+  }
+  return OTA_RESPONSE_OK;
+}
+
+size_t OTADeltaDecoder::header_size_() const {
+  switch (this->state_) {
+    case STATE_MAGIC:
+      return sizeof(DELTA_MAGIC);
+    case STATE_OPCODE:
+      return 1;
+    case STATE_COPY:
+      return 8;
+    case STATE_DATA_LENGTH:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+OTAResponseTypes OTADeltaDecoder::process_header_() {
+  switch (this->state_) {
+    case STATE_MAGIC:
+      if (memcmp(this->header_, DELTA_MAGIC, sizeof(DELTA_MAGIC)) != 0) {
+        ESP_LOGW(TAG, "Patch magic bytes do not match!");
+        return OTA_RESPONSE_ERROR_INVALID_DELTA;
+      }
+      this->state_ = STATE_OPCODE;
+      return OTA_RESPONSE_OK;
+    case STATE_OPCODE:
+      if (this->header_[0] == DELTA_OP_END) {
+        this->state_ = STATE_DONE;
+      } else if (this->header_[0] == DELTA_OP_COPY) {
+        this->state_ = STATE_COPY;
+      } else if (this->header_[0] == DELTA_OP_DATA) {
+        this->state_ = STATE_DATA_LENGTH;
+      } else {
+        ESP_LOGW(TAG, "Unknown patch operation 0x%02X", this->header_[0]);
+        return OTA_RESPONSE_ERROR_INVALID_DELTA;
+      }
+      return OTA_RESPONSE_OK;
+    case STATE_COPY:
+      this->state_ = STATE_OPCODE;
+      return this->copy_(decode_uint32(this->header_), decode_uint32(this->header_ + 4));
+    case STATE_DATA_LENGTH:
+      this->remaining_ = decode_uint32(this->header_);
+      this->state_ = this->remaining_ == 0 ? STATE_OPCODE : STATE_DATA;
+      return OTA_RESPONSE_OK;
+    default:
+      return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+}
+
+OTAResponseTypes OTADeltaDecoder::copy_(uint32_t offset, uint32_t len) {
+  if (offset > this->base_size_ || len > this->base_size_ - offset) {
+    ESP_LOGW(TAG, "Patch copies %u bytes at %u, outside of the running image", len, offset);
+    return OTA_RESPONSE_ERROR_INVALID_DELTA;
+  }
+  uint8_t buf[256];
+  while (len != 0) {
+    size_t chunk = std::min<size_t>(len, sizeof(buf));
+    if (!this->backend_->read_running_image(offset, buf, chunk)) {
+      ESP_LOGW(TAG, "Reading the running image failed!");
+      return OTA_RESPONSE_ERROR_UNKNOWN;
+    }
+    if (!this->writer_->write(buf, chunk))
+      return this->writer_->get_error();
+    this->output_size_ += chunk;
+    offset += chunk;
+    len -= chunk;
+    // Large copies don't wait for the network, so they'd trigger the watchdog otherwise
+    App.feed_wdt();
+  }
+  return OTA_RESPONSE_OK;
+}
+
+}  // namespace ota
+}  // namespace esphome
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ota_backend.h"
+#include "ota_block_writer.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace ota {
+
+/** Applies a delta update received from espota2 to the running firmware image.
+ *
+ * The patch starts with the magic bytes "EDL1", followed by operations that each start with an opcode byte:
+ *  - 0x00: end of the patch.
+ *  - 0x01: copy from the running image, followed by the offset and the length (4 bytes each, MSB first).
+ *  - 0x02: literal data, followed by the length (4 bytes, MSB first) and the data itself.
+ *
+ * The patch is processed as it's received, so it doesn't need to be buffered. The resulting image is written to the
+ * block writer, and is checked against the MD5 of the new image by the backend like a full update.
+ */
+class OTADeltaDecoder {
+ public:
+  OTADeltaDecoder(OTABackend *backend, size_t base_size, OTABlockWriter *writer)
+      : backend_(backend), writer_(writer), base_size_(base_size) {}
+
+  /// Process received patch data, returns an error if the patch is invalid or writing the image failed.
+  OTAResponseTypes feed(const uint8_t *data, size_t len);
+  /// Whether the end of the patch was reached.
+  bool is_done() const { return this->state_ == STATE_DONE; }
+  /// The size of the image written so far.
+  size_t get_output_size() const { return this->output_size_; }
+
+ protected:
+  enum State : uint8_t {
+    STATE_MAGIC,
+    STATE_OPCODE,
+    STATE_COPY,
+    STATE_DATA_LENGTH,
+    STATE_DATA,
+    STATE_DONE,
+  };
+
+  /// The number of header bytes the current state needs.
+  size_t header_size_() const;
+  OTAResponseTypes process_header_();
+  OTAResponseTypes copy_(uint32_t offset, uint32_t len);
+
+  OTABackend *backend_;
+  OTABlockWriter *writer_;
+  size_t base_size_;
+  size_t output_size_{0};
+  State state_{STATE_MAGIC};
+  uint8_t header_[8];
+  size_t header_len_{0};
+  /// The number of literal bytes left in the current data operation.
+  uint32_t remaining_{0};
+};
+
+}  // namespace ota
+}  // namespace esphome
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "esphome/core/preferences.h"
+#include "esphome/core/state_journal.h"
 #include "esphome/core/component.h"
 
 namespace esphome {
@@ -10,9 +11,15 @@ class IntervalSyncer : public Component {
  public:
   void set_write_interval(uint32_t write_interval) { write_interval_ = write_interval; }
   void setup() override {
-    set_interval(write_interval_, []() { global_preferences->sync(); });
+    set_interval(write_interval_, []() {
+      global_state_journal.flush();
+      global_preferences->sync();
+    });
+  }
+  void on_shutdown() override {
+    global_state_journal.flush();
+    global_preferences->sync();
   }
-  void on_shutdown() override { global_preferences->sync(); }
   float get_setup_priority() const override { return setup_priority::BUS; }
 
  protected:
@@ -2,341 +2,326 @@
 
 #include "prometheus_handler.h"
 #include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+
+#include <cmath>
+#include <cstdarg>
+#include <cstring>
 
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+/// Append a printf-formatted row to out, reusing its capacity.
+static void __attribute__((format(printf, 2, 3))) append_row(std::string &out, const char *fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  va_list args_copy;
+  va_copy(args_copy, args);
+  int len = vsnprintf(nullptr, 0, fmt, args);
+  va_end(args);
+  if (len > 0) {
+    size_t offset = out.size();
+    out.resize(offset + len);
+    vsnprintf(&out[offset], len + 1, fmt, args_copy);
+  }
+  va_end(args_copy);
+}
 
+static std::string render_labels(EntityBase *obj) {
+  return "id=\"" + obj->get_object_id() + "\",name=\"" + obj->get_name() + "\"";
+}
+
+void PrometheusHandler::setup() {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
-  for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+  for (auto *obj : App.get_sensors()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::SENSOR, render_labels(obj)});
+  }
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
-  for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+  for (auto *obj : App.get_binary_sensors()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::BINARY_SENSOR, render_labels(obj)});
+  }
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
-  for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+  for (auto *obj : App.get_fans()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::FAN, render_labels(obj)});
+  }
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
-  for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+  for (auto *obj : App.get_lights()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::LIGHT, render_labels(obj)});
+  }
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
-  for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+  for (auto *obj : App.get_covers()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::COVER, render_labels(obj)});
+  }
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
-  for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+  for (auto *obj : App.get_switches()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::SWITCH, render_labels(obj)});
+  }
+#endif
+#ifdef USE_LOCK
+  for (auto *obj : App.get_locks()) {
+    if (!obj->is_internal())
+      this->entities_.push_back({obj, MetricType::LOCK, render_labels(obj)});
+  }
 #endif
+  this->entities_.shrink_to_fit();
 
+  this->base_->init();
+  this->base_->add_handler(this);
+}
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  // The rows are rendered lazily, whenever the TCP stack has room for the next chunk
+  auto scrape = std::make_shared<ScrapeState>();
+  AsyncWebServerResponse *response = req->beginChunkedResponse(
+      "text/plain; version=0.0.4; charset=utf-8",
+      [this, scrape](uint8_t *buffer, size_t max_len, size_t index) -> size_t {
+        return this->fill_chunk_(*scrape, buffer, max_len);
+      });
+  req->send(response);
+}
+
+size_t PrometheusHandler::fill_chunk_(ScrapeState &scrape, uint8_t *buffer, size_t max_len) {
+  size_t written = 0;
+  while (written < max_len) {
+    if (scrape.offset == scrape.pending.size()) {
+      if (scrape.at >= this->entities_.size())
+        break;
+      scrape.pending.clear();
+      scrape.offset = 0;
+      this->render_entity_(scrape.at++, scrape.pending);
+      continue;
+    }
+    size_t len = std::min(max_len - written, scrape.pending.size() - scrape.offset);
+    memcpy(buffer + written, scrape.pending.data() + scrape.offset, len);
+    scrape.offset += len;
+    written += len;
+  }
+  return written;
+}
+
+void PrometheusHandler::render_entity_(size_t index, std::string &out) {
+  const MetricEntity &entity = this->entities_[index];
+  if (index == 0 || this->entities_[index - 1].type != entity.type) {
+    switch (entity.type) {
+#ifdef USE_SENSOR
+      case MetricType::SENSOR:
+        this->sensor_type_(out);
+        break;
+#endif
+#ifdef USE_BINARY_SENSOR
+      case MetricType::BINARY_SENSOR:
+        this->binary_sensor_type_(out);
+        break;
+#endif
+#ifdef USE_FAN
+      case MetricType::FAN:
+        this->fan_type_(out);
+        break;
+#endif
+#ifdef USE_LIGHT
+      case MetricType::LIGHT:
+        this->light_type_(out);
+        break;
+#endif
+#ifdef USE_COVER
+      case MetricType::COVER:
+        this->cover_type_(out);
+        break;
+#endif
+#ifdef USE_SWITCH
+      case MetricType::SWITCH:
+        this->switch_type_(out);
+        break;
+#endif
 #ifdef USE_LOCK
-  this->lock_type_(stream);
-  for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+      case MetricType::LOCK:
+        this->lock_type_(out);
+        break;
 #endif
+      default:
+        break;
+    }
+  }
 
-  req->send(stream);
+  switch (entity.type) {
+#ifdef USE_SENSOR
+    case MetricType::SENSOR:
+      this->sensor_row_(out, static_cast<sensor::Sensor *>(entity.obj), entity.labels);
+      break;
+#endif
+#ifdef USE_BINARY_SENSOR
+    case MetricType::BINARY_SENSOR:
+      this->binary_sensor_row_(out, static_cast<binary_sensor::BinarySensor *>(entity.obj), entity.labels);
+      break;
+#endif
+#ifdef USE_FAN
+    case MetricType::FAN:
+      this->fan_row_(out, static_cast<fan::Fan *>(entity.obj), entity.labels);
+      break;
+#endif
+#ifdef USE_LIGHT
+    case MetricType::LIGHT:
+      this->light_row_(out, static_cast<light::LightState *>(entity.obj), entity.labels);
+      break;
+#endif
+#ifdef USE_COVER
+    case MetricType::COVER:
+      this->cover_row_(out, static_cast<cover::Cover *>(entity.obj), entity.labels);
+      break;
+#endif
+#ifdef USE_SWITCH
+    case MetricType::SWITCH:
+      this->switch_row_(out, static_cast<switch_::Switch *>(entity.obj), entity.labels);
+      break;
+#endif
+#ifdef USE_LOCK
+    case MetricType::LOCK:
+      this->lock_row_(out, static_cast<lock::Lock *>(entity.obj), entity.labels);
+      break;
+#endif
+    default:
+      break;
+  }
 }
 
 // Type-specific implementation
 #ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_sensor_failed GAUGE\n"));
+void PrometheusHandler::sensor_type_(std::string &out) {
+  out += "#TYPE esphome_sensor_value GAUGE\n"
+         "#TYPE esphome_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels) {
   if (!std::isnan(obj->state)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
-    // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print('\n');
+    char value[32];
+    value_accuracy_to_buf(value, sizeof(value), obj->state, obj->get_accuracy_decimals());
+    append_row(out, "esphome_sensor_failed{%s} 0\nesphome_sensor_value{%s,unit=\"%s\"} %s\n", labels.c_str(),
+               labels.c_str(), obj->get_unit_of_measurement().c_str(), value);
   } else {
     // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_sensor_failed{%s} 1\n", labels.c_str());
   }
 }
 #endif
 
 // Type-specific implementation
 #ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed GAUGE\n"));
+void PrometheusHandler::binary_sensor_type_(std::string &out) {
+  out += "#TYPE esphome_binary_sensor_value GAUGE\n"
+         "#TYPE esphome_binary_sensor_failed GAUGE\n";
 }
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj,
+                                           const std::string &labels) {
   if (obj->has_state()) {
     // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
-    // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print('\n');
+    append_row(out, "esphome_binary_sensor_failed{%s} 0\nesphome_binary_sensor_value{%s} %d\n", labels.c_str(),
+               labels.c_str(), obj->state);
   } else {
     // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_binary_sensor_failed{%s} 1\n", labels.c_str());
   }
 }
 #endif
 
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_failed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_speed GAUGE\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation GAUGE\n"));
+void PrometheusHandler::fan_type_(std::string &out) {
+  out += "#TYPE esphome_fan_value GAUGE\n"
+         "#TYPE esphome_fan_failed GAUGE\n"
+         "#TYPE esphome_fan_speed GAUGE\n"
+         "#TYPE esphome_fan_oscillation GAUGE\n";
 }
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
-  // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+void PrometheusHandler::fan_row_(std::string &out, fan::Fan *obj, const std::string &labels) {
+  append_row(out, "esphome_fan_failed{%s} 0\nesphome_fan_value{%s} %d\n", labels.c_str(), labels.c_str(), obj->state);
   // Speed if available
-  if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print('\n');
-  }
+  if (obj->get_traits().supports_speed())
+    append_row(out, "esphome_fan_speed{%s} %d\n", labels.c_str(), obj->speed);
   // Oscillation if available
-  if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print('\n');
-  }
+  if (obj->get_traits().supports_oscillation())
+    append_row(out, "esphome_fan_oscillation{%s} %d\n", labels.c_str(), obj->oscillating);
 }
 #endif
 
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_color GAUGE\n"));
-  stream->print(F("#TYPE esphome_light_effect_active GAUGE\n"));
+void PrometheusHandler::light_type_(std::string &out) {
+  out += "#TYPE esphome_light_state GAUGE\n"
+         "#TYPE esphome_light_color GAUGE\n"
+         "#TYPE esphome_light_effect_active GAUGE\n";
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::light_row_(std::string &out, light::LightState *obj, const std::string &labels) {
   // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
+  append_row(out, "esphome_light_state{%s} %d\n", labels.c_str(), obj->remote_values.is_on());
   // Brightness and RGBW
   light::LightColorValues color = obj->current_values;
   float brightness, r, g, b, w;
   color.as_brightness(&brightness);
   color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
+  const char *l = labels.c_str();
+  append_row(out,
+             "esphome_light_color{%s,channel=\"brightness\"} %.2f\n"
+             "esphome_light_color{%s,channel=\"r\"} %.2f\n"
+             "esphome_light_color{%s,channel=\"g\"} %.2f\n"
+             "esphome_light_color{%s,channel=\"b\"} %.2f\n"
+             "esphome_light_color{%s,channel=\"w\"} %.2f\n",
+             l, brightness, l, r, l, g, l, b, l, w);
   // Effect
   std::string effect = obj->get_effect_name();
   if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
+    append_row(out, "esphome_light_effect_active{%s,effect=\"None\"} 0\n", l);
   } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_light_effect_active{%s,effect=\"%s\"} 1\n", l, effect.c_str());
   }
 }
 #endif
 
 #ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_cover_failed GAUGE\n"));
+void PrometheusHandler::cover_type_(std::string &out) {
+  out += "#TYPE esphome_cover_value GAUGE\n"
+         "#TYPE esphome_cover_failed GAUGE\n";
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal())
-    return;
+void PrometheusHandler::cover_row_(std::string &out, cover::Cover *obj, const std::string &labels) {
   if (!std::isnan(obj->position)) {
     // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 0\n"));
-    // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print('\n');
-    if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(obj->get_object_id().c_str());
-      stream->print(F("\",name=\""));
-      stream->print(obj->get_name().c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print('\n');
-    }
+    append_row(out, "esphome_cover_failed{%s} 0\nesphome_cover_value{%s} %.2f\n", labels.c_str(), labels.c_str(),
+               obj->position);
+    if (obj->get_traits().get_supports_tilt())
+      append_row(out, "esphome_cover_tilt{%s} %.2f\n", labels.c_str(), obj->tilt);
   } else {
     // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(obj->get_object_id().c_str());
-    stream->print(F("\",name=\""));
-    stream->print(obj->get_name().c_str());
-    stream->print(F("\"} 1\n"));
+    append_row(out, "esphome_cover_failed{%s} 1\n", labels.c_str());
   }
 }
 #endif
 
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_switch_failed GAUGE\n"));
+void PrometheusHandler::switch_type_(std::string &out) {
+  out += "#TYPE esphome_switch_value GAUGE\n"
+         "#TYPE esphome_switch_failed GAUGE\n";
 }
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
-  // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+void PrometheusHandler::switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels) {
+  append_row(out, "esphome_switch_failed{%s} 0\nesphome_switch_value{%s} %d\n", labels.c_str(), labels.c_str(),
+             obj->state);
 }
 #endif
 
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value GAUGE\n"));
-  stream->print(F("#TYPE esphome_lock_failed GAUGE\n"));
+void PrometheusHandler::lock_type_(std::string &out) {
+  out += "#TYPE esphome_lock_value GAUGE\n"
+         "#TYPE esphome_lock_failed GAUGE\n";
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
-  if (obj->is_internal())
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} 0\n"));
-  // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(obj->get_object_id().c_str());
-  stream->print(F("\",name=\""));
-  stream->print(obj->get_name().c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print('\n');
+void PrometheusHandler::lock_row_(std::string &out, lock::Lock *obj, const std::string &labels) {
+  append_row(out, "esphome_lock_failed{%s} 0\nesphome_lock_value{%s} %u\n", labels.c_str(), labels.c_str(),
+             static_cast<uint8_t>(obj->state));
 }
 #endif
 
@@ -5,10 +5,43 @@
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/component.h"
+#include "esphome/core/entity_base.h"
+
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace esphome {
 namespace prometheus {
 
+enum class MetricType : uint8_t {
+  SENSOR,
+  BINARY_SENSOR,
+  FAN,
+  LIGHT,
+  COVER,
+  SWITCH,
+  LOCK,
+};
+
+/// An entity exposed to prometheus, together with its pre-rendered label set.
+struct MetricEntity {
+  EntityBase *obj;
+  MetricType type;
+  /// The `id="...",name="..."` labels shared by all rows of this entity.
+  std::string labels;
+};
+
+/// Per-request state of a chunked metrics response.
+struct ScrapeState {
+  /// Index of the next entity to render.
+  size_t at{0};
+  /// Rows that were rendered but not yet handed to the TCP stack.
+  std::string pending;
+  /// Number of bytes of pending that were already sent.
+  size_t offset{0};
+};
+
 class PrometheusHandler : public AsyncWebHandler, public Component {
  public:
   PrometheusHandler(web_server_base::WebServerBase *base) : base_(base) {}
@@ -24,66 +57,69 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
 
  protected:
+  /// Fill the next chunk of the response, returns 0 once all entities were sent.
+  size_t fill_chunk_(ScrapeState &scrape, uint8_t *buffer, size_t max_len);
+  /// Render all rows of the entity at the given index, preceded by the type lines if it starts a new type.
+  void render_entity_(size_t index, std::string &out);
+
 #ifdef USE_SENSOR
   /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
+  void sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
+  void sensor_row_(std::string &out, sensor::Sensor *obj, const std::string &labels);
 #endif
 
 #ifdef USE_BINARY_SENSOR
   /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
+  void binary_sensor_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
+  void binary_sensor_row_(std::string &out, binary_sensor::BinarySensor *obj, const std::string &labels);
 #endif
 
 #ifdef USE_FAN
   /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
+  void fan_type_(std::string &out);
   /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj);
+  void fan_row_(std::string &out, fan::Fan *obj, const std::string &labels);
 #endif
 
 #ifdef USE_LIGHT
   /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
+  void light_type_(std::string &out);
   /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
+  void light_row_(std::string &out, light::LightState *obj, const std::string &labels);
 #endif
 
 #ifdef USE_COVER
   /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
+  void cover_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
+  void cover_row_(std::string &out, cover::Cover *obj, const std::string &labels);
 #endif
 
 #ifdef USE_SWITCH
   /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
+  void switch_type_(std::string &out);
   /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
+  void switch_row_(std::string &out, switch_::Switch *obj, const std::string &labels);
 #endif
 
 #ifdef USE_LOCK
   /// Return the type for prometheus
-  void lock_type_(AsyncResponseStream *stream);
+  void lock_type_(std::string &out);
   /// Return the lock Values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
+  void lock_row_(std::string &out, lock::Lock *obj, const std::string &labels);
 #endif
 
   web_server_base::WebServerBase *base_;
+  std::vector<MetricEntity> entities_;
 };
 
 }  // namespace prometheus
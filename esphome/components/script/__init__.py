@@ -79,6 +79,7 @@ async def to_code(config):
 
     for trigger, conf in triggers:
         await automation.build_automation(trigger, [], conf)
+        cg.add(trigger.add_finished_action())
 
 
 @automation.register_action(
@@ -1,66 +1,114 @@
 #include "script.h"
+#include "esphome/core/base_automation.h"
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace script {
 
 static const char *const TAG = "script";
 
+void Script::stop() {
+  this->stop_action();
+  this->running_instances_ = 0;
+}
+
+void Script::add_finished_action() {
+  if (this->automation_parent_ == nullptr)
+    return;
+  this->automation_parent_->add_actions({new LambdaAction<>([this]() { this->on_instance_finished_(); })});
+}
+
+void Script::start_instance_() {
+  this->running_instances_++;
+  this->trigger();
+}
+
+void Script::on_instance_finished_() {
+  if (this->running_instances_ > 0)
+    this->running_instances_--;
+}
+
 void SingleScript::execute() {
   if (this->is_action_running()) {
     ESP_LOGW(TAG, "Script '%s' is already running! (mode: single)", this->name_.c_str());
     return;
   }
 
-  this->trigger();
+  this->start_instance_();
 }
 
 void RestartScript::execute() {
   if (this->is_action_running()) {
     ESP_LOGD(TAG, "Script '%s' restarting (mode: restart)", this->name_.c_str());
-    this->stop_action();
+    Script::stop();
   }
 
-  this->trigger();
+  this->start_instance_();
+}
+
+void QueueingScript::set_max_runs(int max_runs) {
+  this->max_runs_ = max_runs;
+  this->queue_.resize(max_runs > 1 ? max_runs - 1 : 0);
 }
 
 void QueueingScript::execute() {
-  if (this->is_action_running()) {
-    // num_runs_ is the number of *queued* instances, so total number of instances is
-    // num_runs_ + 1
-    if (this->max_runs_ != 0 && this->num_runs_ + 1 >= this->max_runs_) {
+  if (this->is_action_running() || this->queue_size_ != 0) {
+    // queue_size_ is the number of *queued* instances, so total number of instances is
+    // queue_size_ + 1
+    if (this->max_runs_ != 0 && this->queue_size_ + 1 >= this->max_runs_) {
       ESP_LOGW(TAG, "Script '%s' maximum number of queued runs exceeded!", this->name_.c_str());
       return;
     }
 
+    if (this->queue_size_ == (int) this->queue_.size()) {
+      // Only without max_runs, move the queued instances to the front of the new buffer
+      std::rotate(this->queue_.begin(), this->queue_.begin() + this->queue_start_, this->queue_.end());
+      this->queue_start_ = 0;
+      this->queue_.resize(std::max<size_t>(this->queue_.size() * 2, 4));
+    }
+
     ESP_LOGD(TAG, "Script '%s' queueing new instance (mode: queued)", this->name_.c_str());
-    this->num_runs_++;
+    this->queue_[(this->queue_start_ + this->queue_size_) % this->queue_.size()] = millis();
+    this->queue_size_++;
     return;
   }
 
-  this->trigger();
-  // Check if the trigger was immediate and we can continue right away.
-  this->loop();
+  this->start_instance_();
 }
 
 void QueueingScript::stop() {
-  this->num_runs_ = 0;
+  this->queue_size_ = 0;
+  this->queue_start_ = 0;
+  this->cancel_timer(&this->next_timer_);
   Script::stop();
 }
 
-void QueueingScript::loop() {
-  if (this->num_runs_ != 0 && !this->is_action_running()) {
-    this->num_runs_--;
-    this->trigger();
-  }
+void QueueingScript::on_instance_finished_() {
+  Script::on_instance_finished_();
+  // Start the next instance from the main loop, after the finished one has left the actions
+  if (this->queue_size_ != 0)
+    this->set_timer(&this->next_timer_, 0);
+}
+
+void QueueingScript::start_next_() {
+  if (this->queue_size_ == 0)
+    return;
+  uint32_t queued_at = this->queue_[this->queue_start_];
+  this->queue_start_ = (this->queue_start_ + 1) % this->queue_.size();
+  this->queue_size_--;
+  this->max_latency_ = std::max(this->max_latency_, millis() - queued_at);
+  this->start_instance_();
 }
 
 void ParallelScript::execute() {
-  if (this->max_runs_ != 0 && this->automation_parent_->num_running() >= this->max_runs_) {
+  if (this->max_runs_ != 0 && this->running_instances_ >= this->max_runs_) {
     ESP_LOGW(TAG, "Script '%s' maximum number of parallel runs exceeded!", this->name_.c_str());
     return;
   }
-  this->trigger();
+  this->start_instance_();
 }
 
 }  // namespace script
@@ -2,6 +2,9 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/scheduler.h"
+
+#include <vector>
 
 namespace esphome {
 namespace script {
@@ -17,13 +20,33 @@ class Script : public Trigger<> {
   /// Check if any instance of this script is currently running.
   virtual bool is_running() { return this->is_action_running(); }
   /// Stop all instances of this script.
-  virtual void stop() { this->stop_action(); }
+  virtual void stop();
+
+  /** Add an action to the end of the script that keeps track of instances that finish.
+   *
+   * Must be called after all other actions of the script have been added.
+   */
+  void add_finished_action();
+
+  /// The number of instances of this script that are currently running.
+  int get_running_instances() const { return this->running_instances_; }
+  /// The number of instances that wait for the running instance to finish.
+  virtual int get_queue_depth() const { return 0; }
+  /// The longest time in ms an instance had to wait before it started.
+  uint32_t get_max_latency() const { return this->max_latency_; }
 
   // Internal function to give scripts readable names.
   void set_name(const std::string &name) { name_ = name; }
 
  protected:
+  /// Start a new instance of the script.
+  void start_instance_();
+  /// Called when an instance reaches the end of the script.
+  virtual void on_instance_finished_();
+
   std::string name_;
+  int running_instances_{0};
+  uint32_t max_latency_{0};
 };
 
 /** A script type for which only a single instance at a time is allowed.
@@ -48,18 +71,27 @@ class RestartScript : public Script {
 
 /** A script type that queues new instances that are created.
  *
- * Only one instance of the script can be active at a time.
+ * Only one instance of the script can be active at a time. The queue holds at most max_runs - 1 instances and is
+ * allocated up front, without max_runs it grows as needed. The next instance is started from the main loop once the
+ * running one finishes.
  */
 class QueueingScript : public Script, public Component {
  public:
   void execute() override;
   void stop() override;
-  void loop() override;
-  void set_max_runs(int max_runs) { max_runs_ = max_runs; }
+  void set_max_runs(int max_runs);
+  int get_queue_depth() const override { return this->queue_size_; }
 
  protected:
-  int num_runs_ = 0;
+  void on_instance_finished_() override;
+  void start_next_();
+
   int max_runs_ = 0;
+  /// Ring buffer with the time each queued instance was queued at.
+  std::vector<uint32_t> queue_;
+  size_t queue_start_{0};
+  int queue_size_{0};
+  SchedulerTimer next_timer_{[this]() { this->start_next_(); }};
 };
 
 /** A script type that executes new instances in parallel.
@@ -117,7 +149,7 @@ template<typename... Ts> class ScriptWaitAction : public Action<Ts...>, public C
       this->play_next_(x...);
       return;
     }
-    this->var_ = std::make_tuple(x...);
+    this->var_ = std::tie(x...);
     this->loop();
   }
 
@@ -52,9 +52,12 @@ void SHT3XDComponent::update() {
     return;
   }
 
-  this->set_timeout(50, [this]() {
+  // Let the bus read the measurement together with other devices once it's ready
+  auto transaction = this->transaction(50);
+  transaction.read(this->measurement_, sizeof(this->measurement_));
+  this->submit(std::move(transaction), [this](i2c::ErrorCode err) {
     uint16_t raw_data[2];
-    if (!this->read_data_(raw_data, 2)) {
+    if (err != i2c::ERROR_OK || !this->parse_data_(this->measurement_, raw_data, 2)) {
       this->status_set_warning();
       return;
     }
@@ -108,7 +111,10 @@ bool SHT3XDComponent::read_data_(uint16_t *data, uint8_t len) {
   if (this->read(buf.data(), num_bytes) != i2c::ERROR_OK) {
     return false;
   }
+  return this->parse_data_(buf.data(), data, len);
+}
 
+bool SHT3XDComponent::parse_data_(const uint8_t *buf, uint16_t *data, uint8_t len) {
   for (uint8_t i = 0; i < len; i++) {
     const uint8_t j = 3 * i;
     uint8_t crc = sht_crc(buf[j], buf[j + 1]);
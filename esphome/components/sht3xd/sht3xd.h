@@ -21,7 +21,11 @@ class SHT3XDComponent : public PollingComponent, public i2c::I2CDevice {
  protected:
   bool write_command_(uint16_t command);
   bool read_data_(uint16_t *data, uint8_t len);
+  /// Check the CRC of the len words in buf, each followed by its CRC, and store them in data.
+  bool parse_data_(const uint8_t *buf, uint16_t *data, uint8_t len);
 
+  /// The measurement read by the transaction queued in update().
+  uint8_t measurement_[6];
   sensor::Sensor *temperature_sensor_;
   sensor::Sensor *humidity_sensor_;
 };
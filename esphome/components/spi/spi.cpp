@@ -8,7 +8,14 @@ namespace spi {
 
 static const char *const TAG = "spi";
 
+#ifdef USE_ESP32
+/// The number of writes that can be queued before queue_write() blocks.
+static const size_t WRITE_QUEUE_LENGTH = 4;
+#endif
+
 void IRAM_ATTR HOT SPIComponent::disable() {
+  if (!this->write_callbacks_.empty())
+    this->wait_queued_writes();
 #ifdef USE_SPI_ARDUINO_BACKEND
   if (this->hw_spi_ != nullptr) {
     this->hw_spi_->endTransaction();
@@ -19,6 +26,66 @@ void IRAM_ATTR HOT SPIComponent::disable() {
     this->active_cs_ = nullptr;
   }
 }
+void SPIComponent::queue_write_(const uint8_t *data, size_t length, WriteFunction write,
+                                std::function<void()> &&callback) {
+#ifdef USE_ESP32
+  if (this->write_queue_ == nullptr) {
+    this->write_queue_ = xQueueCreate(WRITE_QUEUE_LENGTH, sizeof(QueuedWrite));
+    // The task can finish one more write than the queue holds
+    this->write_done_ = xSemaphoreCreateCounting(WRITE_QUEUE_LENGTH + 1, 0);
+    if (this->write_queue_ == nullptr || this->write_done_ == nullptr ||
+        xTaskCreate(SPIComponent::write_task, "spi_write", 2048, this, uxTaskPriorityGet(nullptr), nullptr) != pdPASS) {
+      ESP_LOGE(TAG, "Failed to start the write task");
+      this->mark_failed();
+    }
+  }
+  if (!this->is_failed()) {
+    QueuedWrite queued{data, length, write};
+    this->write_callbacks_.push_back(std::move(callback));
+    xQueueSend(this->write_queue_, &queued, portMAX_DELAY);
+    // Call the callbacks of writes that are already done
+    this->finish_queued_writes_(this->write_callbacks_.size());
+    return;
+  }
+#endif
+  (this->*write)(data, length);
+  if (callback)
+    callback();
+}
+
+void SPIComponent::wait_queued_writes(size_t max_pending) { this->finish_queued_writes_(max_pending); }
+
+void SPIComponent::finish_queued_writes_(size_t max_pending) {
+#ifdef USE_ESP32
+  while (!this->write_callbacks_.empty()) {
+    if (xSemaphoreTake(this->write_done_, 0) != pdTRUE) {
+      if (this->write_callbacks_.size() <= max_pending)
+        return;
+      // Writes only take long for a lot of data at a low data rate
+      while (xSemaphoreTake(this->write_done_, 10 / portTICK_PERIOD_MS) != pdTRUE)
+        App.feed_wdt();
+    }
+    auto callback = std::move(this->write_callbacks_.front());
+    this->write_callbacks_.pop_front();
+    if (callback)
+      callback();
+  }
+#endif
+}
+
+#ifdef USE_ESP32
+void SPIComponent::write_task(void *param) {
+  auto *spi = static_cast<SPIComponent *>(param);
+  QueuedWrite queued;
+  while (true) {
+    if (xQueueReceive(spi->write_queue_, &queued, portMAX_DELAY) != pdTRUE)
+      continue;
+    (spi->*queued.write)(queued.data, queued.length);
+    xSemaphoreGive(spi->write_done_);
+  }
+}
+#endif
+
 void SPIComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up SPI bus...");
   this->clk_->setup();
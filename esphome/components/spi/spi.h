@@ -2,6 +2,8 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include <deque>
+#include <functional>
 #include <vector>
 
 #ifdef USE_ARDUINO
@@ -12,6 +14,12 @@
 #include <SPI.h>
 #endif
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#endif
+
 namespace esphome {
 namespace spi {
 
@@ -222,9 +230,32 @@ class SPIComponent : public Component {
 
   void disable();
 
+  /** Queue a write of length bytes at data, so the caller can prepare the next data while it's sent.
+   *
+   * On the ESP32 queued writes are sent by a separate task, elsewhere they are sent right away. The data must stay
+   * valid and unchanged until the write is done, and the bus must not be used otherwise until then, see
+   * wait_queued_writes(). disable() waits for all queued writes. The callback is called from the main loop once the
+   * write is done.
+   */
+  template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE>
+  void queue_write(const uint8_t *data, size_t length, std::function<void()> &&callback = nullptr) {
+    this->queue_write_(data, length, &SPIComponent::write_array<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>,
+                       std::move(callback));
+  }
+  /// Wait until at most max_pending queued writes aren't done yet, and call the callbacks of the finished ones.
+  void wait_queued_writes(size_t max_pending = 0);
+  /// The number of queued writes that aren't done yet, or whose callbacks haven't been called yet.
+  size_t get_queued_writes() const { return this->write_callbacks_.size(); }
+
   float get_setup_priority() const override;
 
  protected:
+  using WriteFunction = void (SPIComponent::*)(const uint8_t *, size_t);
+
+  void queue_write_(const uint8_t *data, size_t length, WriteFunction write, std::function<void()> &&callback);
+  /// Call the callbacks of the finished queued writes, waiting until at most max_pending aren't done yet.
+  void finish_queued_writes_(size_t max_pending);
+
   inline void cycle_clock_(bool value);
 
   template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, bool READ, bool WRITE>
@@ -238,6 +269,21 @@ class SPIComponent : public Component {
   SPIClass *hw_spi_{nullptr};
 #endif  // USE_SPI_ARDUINO_BACKEND
   uint32_t wait_cycle_;
+  /// The callbacks of the queued writes in order, an entry is removed once its write is done.
+  std::deque<std::function<void()>> write_callbacks_;
+#ifdef USE_ESP32
+  struct QueuedWrite {
+    const uint8_t *data;
+    size_t length;
+    WriteFunction write;
+  };
+
+  static void write_task(void *param);
+
+  QueueHandle_t write_queue_{nullptr};
+  /// Given by the write task for every finished write.
+  SemaphoreHandle_t write_done_{nullptr};
+#endif
 };
 
 template<SPIBitOrder BIT_ORDER, SPIClockPolarity CLOCK_POLARITY, SPIClockPhase CLOCK_PHASE, SPIDataRate DATA_RATE>
@@ -260,6 +306,14 @@ class SPIDevice {
 
   void disable() { this->parent_->disable(); }
 
+  /// Queue a write on the bus, see SPIComponent::queue_write().
+  void queue_write(const uint8_t *data, size_t length, std::function<void()> &&callback = nullptr) {
+    this->parent_->template queue_write<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(data, length, std::move(callback));
+  }
+
+  /// Wait until at most max_pending queued writes aren't done yet, see SPIComponent::wait_queued_writes().
+  void wait_queued_writes(size_t max_pending = 0) { this->parent_->wait_queued_writes(max_pending); }
+
   uint8_t read_byte() { return this->parent_->template read_byte<BIT_ORDER, CLOCK_POLARITY, CLOCK_PHASE>(); }
 
   void read_array(uint8_t *data, size_t length) {
@@ -40,6 +40,10 @@ template<typename... Ts> class ToggleAction : public Action<Ts...> {
 template<typename... Ts> class SwitchCondition : public Condition<Ts...> {
  public:
   SwitchCondition(Switch *parent, bool state) : parent_(parent), state_(state) {}
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    this->parent_->add_on_state_callback([callback](bool state) { callback(); });
+    return true;
+  }
   bool check(Ts... x) override { return this->parent_->state == this->state_; }
 
  protected:
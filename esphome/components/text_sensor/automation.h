@@ -29,6 +29,13 @@ template<typename... Ts> class TextSensorStateCondition : public Condition<Ts...
 
   TEMPLATABLE_VALUE(std::string, state)
 
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    // A lambda can return another state at any time, so that has to be polled
+    if (this->state_.is_lambda())
+      return false;
+    this->parent_->add_on_state_callback([callback](const std::string &state) { callback(); });
+    return true;
+  }
   bool check(Ts... x) override { return this->parent_->state == this->state_.value(x...); }
 
  protected:
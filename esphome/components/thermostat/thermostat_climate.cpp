@@ -6,6 +6,72 @@ namespace thermostat {
 
 static const char *const TAG = "thermostat.climate";
 
+static const climate::ClimateAction ACTION_OFF = climate::CLIMATE_ACTION_OFF;
+static const climate::ClimateAction ACTION_IDLE = climate::CLIMATE_ACTION_IDLE;
+static const climate::ClimateAction ACTION_COOL = climate::CLIMATE_ACTION_COOLING;
+static const climate::ClimateAction ACTION_HEAT = climate::CLIMATE_ACTION_HEATING;
+static const climate::ClimateAction ACTION_FAN = climate::CLIMATE_ACTION_FAN;
+static const climate::ClimateAction ACTION_DRY = climate::CLIMATE_ACTION_DRYING;
+
+static_assert(climate::CLIMATE_MODE_AUTO == 6, "MODE_ACTIONS has a row for every climate mode");
+
+/// The action of each mode, indexed by the required demands: bit 0 cooling, bit 1 heating, bit 2 fanning.
+/// When both cooling and heating are required, something is wrong and we just stop.
+static const climate::ClimateAction MODE_ACTIONS[7][8] = {
+    // OFF
+    {ACTION_OFF, ACTION_OFF, ACTION_OFF, ACTION_OFF, ACTION_OFF, ACTION_OFF, ACTION_OFF, ACTION_OFF},
+    // HEAT_COOL
+    {ACTION_IDLE, ACTION_COOL, ACTION_HEAT, ACTION_IDLE, ACTION_IDLE, ACTION_COOL, ACTION_HEAT, ACTION_IDLE},
+    // COOL
+    {ACTION_IDLE, ACTION_COOL, ACTION_IDLE, ACTION_COOL, ACTION_IDLE, ACTION_COOL, ACTION_IDLE, ACTION_COOL},
+    // HEAT
+    {ACTION_IDLE, ACTION_IDLE, ACTION_HEAT, ACTION_HEAT, ACTION_IDLE, ACTION_IDLE, ACTION_HEAT, ACTION_HEAT},
+    // FAN_ONLY
+    {ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_FAN, ACTION_FAN, ACTION_FAN, ACTION_FAN},
+    // DRY
+    {ACTION_DRY, ACTION_DRY, ACTION_DRY, ACTION_DRY, ACTION_DRY, ACTION_DRY, ACTION_DRY, ACTION_DRY},
+    // AUTO
+    {ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE},
+};
+
+/// The supplemental action of each mode, indexed by the required demands: bit 0 cooling, bit 1 heating.
+static const climate::ClimateAction MODE_SUPPLEMENTAL_ACTIONS[7][4] = {
+    {ACTION_OFF, ACTION_OFF, ACTION_OFF, ACTION_OFF},        // OFF
+    {ACTION_IDLE, ACTION_COOL, ACTION_HEAT, ACTION_IDLE},    // HEAT_COOL
+    {ACTION_IDLE, ACTION_COOL, ACTION_IDLE, ACTION_COOL},    // COOL
+    {ACTION_IDLE, ACTION_IDLE, ACTION_HEAT, ACTION_HEAT},    // HEAT
+    {ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE},    // FAN_ONLY
+    {ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE},    // DRY
+    {ACTION_IDLE, ACTION_IDLE, ACTION_IDLE, ACTION_IDLE},    // AUTO
+};
+
+/// Whether a demand is required, indexed by the zone of the temperature and whether the demand is already active.
+static const bool DEMAND_REQUIRED[3][2] = {
+    {false, false},  // DEMAND_ZONE_OFF
+    {false, true},   // DEMAND_ZONE_HOLD
+    {true, true},    // DEMAND_ZONE_ON
+};
+
+/// The zone of a demand that starts above on and stops below off. Negate all values for a demand that starts below on.
+static ThermostatDemandZone demand_zone(float value, float on, float off) {
+  if (value > on)
+    return DEMAND_ZONE_ON;
+  if (value < off)
+    return DEMAND_ZONE_OFF;
+  return DEMAND_ZONE_HOLD;
+}
+
+static bool same_temperature(float a, float b) { return a == b || (std::isnan(a) && std::isnan(b)); }
+
+bool ThermostatClimatePublishedState::operator==(const ThermostatClimatePublishedState &other) const {
+  return this->mode == other.mode && this->action == other.action && this->fan_mode == other.fan_mode &&
+         this->swing_mode == other.swing_mode && this->preset == other.preset &&
+         same_temperature(this->current_temperature, other.current_temperature) &&
+         same_temperature(this->target_temperature, other.target_temperature) &&
+         same_temperature(this->target_temperature_low, other.target_temperature_low) &&
+         same_temperature(this->target_temperature_high, other.target_temperature_high);
+}
+
 void ThermostatClimate::setup() {
   if (this->use_startup_delay_) {
     // start timers so that no actions are called for a moment
@@ -18,11 +84,12 @@ void ThermostatClimate::setup() {
   // add a callback so that whenever the sensor state changes we can take action
   this->sensor_->add_on_state_callback([this](float state) {
     this->current_temperature = state;
-    // required action may have changed, recompute, refresh, we'll publish_state() later
-    this->switch_to_action_(this->compute_action_(), false);
-    this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+    // the actions only depend on the temperature through its zones, so they only need to be recomputed
+    //  when the temperature crossed a threshold or an earlier transition is still pending
+    if (this->update_zones_() || this->transition_pending_)
+      this->update_actions_();
     // current temperature and possibly action changed, so publish the new state
-    this->publish_state();
+    this->publish_state_if_changed_();
   });
   this->current_temperature = this->sensor_->state;
   // restore all climate data, if possible
@@ -35,10 +102,9 @@ void ThermostatClimate::setup() {
     this->change_away_(false);
   }
   // refresh the climate action based on the restored settings, we'll publish_state() later
-  this->switch_to_action_(this->compute_action_(), false);
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
   this->setup_complete_ = true;
-  this->publish_state();
+  this->publish_state_if_changed_();
 }
 
 float ThermostatClimate::cool_deadband() { return this->cooling_deadband_; }
@@ -48,11 +114,77 @@ float ThermostatClimate::heat_overrun() { return this->heating_overrun_; }
 
 void ThermostatClimate::refresh() {
   this->switch_to_mode_(this->mode, false);
-  this->switch_to_action_(this->compute_action_(), false);
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
   this->switch_to_fan_mode_(this->fan_mode.value(), false);
   this->switch_to_swing_mode_(this->swing_mode, false);
   this->check_temperature_change_trigger_();
+  this->publish_state_if_changed_();
+}
+
+void ThermostatClimate::update_actions_() {
+  this->switch_to_action_(this->compute_action_(), false);
+  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->transition_pending_ = this->compute_action_(true) != this->action ||
+                              this->compute_supplemental_action_() != this->supplemental_action_;
+}
+
+void ThermostatClimate::update_thresholds_() {
+  bool unchanged = this->supports_two_points_
+                       ? this->target_temperature_low == this->thresholds_target_temperature_low_ &&
+                             this->target_temperature_high == this->thresholds_target_temperature_high_
+                       : this->target_temperature == this->thresholds_target_temperature_;
+  if (this->thresholds_valid_ && unchanged)
+    return;
+
+  // ensure set point(s) is/are valid before computing the thresholds
+  this->validate_target_temperatures();
+  this->thresholds_target_temperature_ = this->target_temperature;
+  this->thresholds_target_temperature_low_ = this->target_temperature_low;
+  this->thresholds_target_temperature_high_ = this->target_temperature_high;
+  this->thresholds_valid_ = true;
+
+  auto cool_temperature = this->supports_two_points_ ? this->target_temperature_high : this->target_temperature;
+  auto heat_temperature = this->supports_two_points_ ? this->target_temperature_low : this->target_temperature;
+  this->thresholds_.cool_on = cool_temperature + this->cooling_deadband_;
+  this->thresholds_.cool_off = cool_temperature - this->cooling_overrun_;
+  this->thresholds_.heat_on = heat_temperature - this->heating_deadband_;
+  this->thresholds_.heat_off = heat_temperature + this->heating_overrun_;
+  this->thresholds_.supplemental_cool = cool_temperature + this->supplemental_cool_delta_;
+  this->thresholds_.supplemental_heat = heat_temperature - this->supplemental_heat_delta_;
+}
+
+bool ThermostatClimate::update_zones_() {
+  ThermostatClimateZones zones{};
+  if (!std::isnan(this->current_temperature)) {
+    this->update_thresholds_();
+    const auto &thresholds = this->thresholds_;
+    const float temperature = this->current_temperature;
+    zones.valid = true;
+    zones.cool = demand_zone(temperature, thresholds.cool_on, thresholds.cool_off);
+    zones.heat = demand_zone(-temperature, -thresholds.heat_on, -thresholds.heat_off);
+    zones.supplemental_cool = temperature > thresholds.supplemental_cool;
+    zones.supplemental_heat = temperature < thresholds.supplemental_heat;
+  }
+  if (zones == this->zones_)
+    return false;
+  this->zones_ = zones;
+  return true;
+}
+
+void ThermostatClimate::publish_state_if_changed_() {
+  ThermostatClimatePublishedState state{this->mode,
+                                        this->action,
+                                        this->fan_mode,
+                                        this->swing_mode,
+                                        this->preset,
+                                        this->current_temperature,
+                                        this->target_temperature,
+                                        this->target_temperature_low,
+                                        this->target_temperature_high};
+  if (this->state_published_ && state == this->published_state_)
+    return;
+  this->published_state_ = state;
+  this->state_published_ = true;
   this->publish_state();
 }
 
@@ -257,43 +389,13 @@ climate::ClimateAction ThermostatClimate::compute_action_(const bool ignore_time
     return this->action;
   }
 
-  // ensure set point(s) is/are valid before computing the action
-  this->validate_target_temperatures();
-  // everything has been validated so we can now safely compute the action
-  switch (this->mode) {
-    // if the climate mode is OFF then the climate action must be OFF
-    case climate::CLIMATE_MODE_OFF:
-      target_action = climate::CLIMATE_ACTION_OFF;
-      break;
-    case climate::CLIMATE_MODE_FAN_ONLY:
-      if (this->fanning_required_())
-        target_action = climate::CLIMATE_ACTION_FAN;
-      break;
-    case climate::CLIMATE_MODE_DRY:
-      target_action = climate::CLIMATE_ACTION_DRYING;
-      break;
-    case climate::CLIMATE_MODE_HEAT_COOL:
-      if (this->cooling_required_() && this->heating_required_()) {
-        // this is bad and should never happen, so just stop.
-        // target_action = climate::CLIMATE_ACTION_IDLE;
-      } else if (this->cooling_required_()) {
-        target_action = climate::CLIMATE_ACTION_COOLING;
-      } else if (this->heating_required_()) {
-        target_action = climate::CLIMATE_ACTION_HEATING;
-      }
-      break;
-    case climate::CLIMATE_MODE_COOL:
-      if (this->cooling_required_()) {
-        target_action = climate::CLIMATE_ACTION_COOLING;
-      }
-      break;
-    case climate::CLIMATE_MODE_HEAT:
-      if (this->heating_required_()) {
-        target_action = climate::CLIMATE_ACTION_HEATING;
-      }
-      break;
-    default:
-      break;
+  // ensure set point(s) is/are valid and the zones are up to date before computing the action
+  this->update_zones_();
+  // everything has been validated so we can now safely look up the action of the mode
+  if (this->mode <= climate::CLIMATE_MODE_AUTO) {
+    uint8_t demands = uint8_t(this->cooling_required_()) | uint8_t(this->heating_required_()) << 1 |
+                      uint8_t(this->fanning_required_()) << 2;
+    target_action = MODE_ACTIONS[this->mode][demands];
   }
   // do not abruptly switch actions. cycle through IDLE, first. we'll catch this at the next update.
   if ((((this->action == climate::CLIMATE_ACTION_COOLING) || (this->action == climate::CLIMATE_ACTION_DRYING)) &&
@@ -313,36 +415,13 @@ climate::ClimateAction ThermostatClimate::compute_supplemental_action_() {
     return climate::CLIMATE_ACTION_OFF;
   }
 
-  // ensure set point(s) is/are valid before computing the action
-  this->validate_target_temperatures();
-  // everything has been validated so we can now safely compute the action
-  switch (this->mode) {
-    // if the climate mode is OFF then the climate action must be OFF
-    case climate::CLIMATE_MODE_OFF:
-      target_action = climate::CLIMATE_ACTION_OFF;
-      break;
-    case climate::CLIMATE_MODE_HEAT_COOL:
-      if (this->supplemental_cooling_required_() && this->supplemental_heating_required_()) {
-        // this is bad and should never happen, so just stop.
-        // target_action = climate::CLIMATE_ACTION_IDLE;
-      } else if (this->supplemental_cooling_required_()) {
-        target_action = climate::CLIMATE_ACTION_COOLING;
-      } else if (this->supplemental_heating_required_()) {
-        target_action = climate::CLIMATE_ACTION_HEATING;
-      }
-      break;
-    case climate::CLIMATE_MODE_COOL:
-      if (this->supplemental_cooling_required_()) {
-        target_action = climate::CLIMATE_ACTION_COOLING;
-      }
-      break;
-    case climate::CLIMATE_MODE_HEAT:
-      if (this->supplemental_heating_required_()) {
-        target_action = climate::CLIMATE_ACTION_HEATING;
-      }
-      break;
-    default:
-      break;
+  // ensure set point(s) is/are valid and the zones are up to date before computing the action
+  this->update_zones_();
+  // everything has been validated so we can now safely look up the action of the mode
+  if (this->mode <= climate::CLIMATE_MODE_AUTO) {
+    uint8_t demands =
+        uint8_t(this->supplemental_cooling_required_()) | uint8_t(this->supplemental_heating_required_()) << 1;
+    target_action = MODE_SUPPLEMENTAL_ACTIONS[this->mode][demands];
   }
 
   return target_action;
@@ -362,7 +441,7 @@ void ThermostatClimate::switch_to_action_(climate::ClimateAction action, bool pu
     // OFF means user manually disabled, IDLE means the temperature is in target range.
     this->action = action;
     if (publish_state)
-      this->publish_state();
+      this->publish_state_if_changed_();
     return;
   }
 
@@ -460,7 +539,7 @@ void ThermostatClimate::switch_to_action_(climate::ClimateAction action, bool pu
       trig_fan->trigger();
     }
     if (publish_state)
-      this->publish_state();
+      this->publish_state_if_changed_();
   }
 }
 
@@ -528,7 +607,7 @@ void ThermostatClimate::switch_to_fan_mode_(climate::ClimateFanMode fan_mode, bo
 
   this->fan_mode = fan_mode;
   if (publish_state)
-    this->publish_state();
+    this->publish_state_if_changed_();
 
   if (this->fan_mode_ready_()) {
     Trigger<> *trig = this->fan_mode_auto_trigger_;
@@ -630,7 +709,7 @@ void ThermostatClimate::switch_to_mode_(climate::ClimateMode mode, bool publish_
   this->prev_mode_ = mode;
   this->prev_mode_trigger_ = trig;
   if (publish_state)
-    this->publish_state();
+    this->publish_state_if_changed_();
 }
 
 void ThermostatClimate::switch_to_swing_mode_(climate::ClimateSwingMode swing_mode, bool publish_state) {
@@ -670,7 +749,7 @@ void ThermostatClimate::switch_to_swing_mode_(climate::ClimateSwingMode swing_mo
   this->prev_swing_mode_ = swing_mode;
   this->prev_swing_mode_trigger_ = trig;
   if (publish_state)
-    this->publish_state();
+    this->publish_state_if_changed_();
 }
 
 bool ThermostatClimate::idle_action_ready_() {
@@ -742,15 +821,15 @@ void ThermostatClimate::cooling_max_run_time_timer_callback_() {
 void ThermostatClimate::cooling_off_timer_callback_() {
   ESP_LOGVV(TAG, "cooling_off timer expired");
   this->timer_[thermostat::TIMER_COOLING_OFF].active = false;
-  this->switch_to_action_(this->compute_action_());
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
+  this->publish_state_if_changed_();
 }
 
 void ThermostatClimate::cooling_on_timer_callback_() {
   ESP_LOGVV(TAG, "cooling_on timer expired");
   this->timer_[thermostat::TIMER_COOLING_ON].active = false;
-  this->switch_to_action_(this->compute_action_());
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
+  this->publish_state_if_changed_();
 }
 
 void ThermostatClimate::fan_mode_timer_callback_() {
@@ -784,22 +863,22 @@ void ThermostatClimate::heating_max_run_time_timer_callback_() {
 void ThermostatClimate::heating_off_timer_callback_() {
   ESP_LOGVV(TAG, "heating_off timer expired");
   this->timer_[thermostat::TIMER_HEATING_OFF].active = false;
-  this->switch_to_action_(this->compute_action_());
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
+  this->publish_state_if_changed_();
 }
 
 void ThermostatClimate::heating_on_timer_callback_() {
   ESP_LOGVV(TAG, "heating_on timer expired");
   this->timer_[thermostat::TIMER_HEATING_ON].active = false;
-  this->switch_to_action_(this->compute_action_());
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
+  this->publish_state_if_changed_();
 }
 
 void ThermostatClimate::idle_on_timer_callback_() {
   ESP_LOGVV(TAG, "idle_on timer expired");
   this->timer_[thermostat::TIMER_IDLE_ON].active = false;
-  this->switch_to_action_(this->compute_action_());
-  this->switch_to_supplemental_action_(this->compute_supplemental_action_());
+  this->update_actions_();
+  this->publish_state_if_changed_();
 }
 
 void ThermostatClimate::check_temperature_change_trigger_() {
@@ -828,85 +907,46 @@ void ThermostatClimate::check_temperature_change_trigger_() {
 }
 
 bool ThermostatClimate::cooling_required_() {
-  auto temperature = this->supports_two_points_ ? this->target_temperature_high : this->target_temperature;
-
-  if (this->supports_cool_) {
-    if (this->current_temperature > temperature + this->cooling_deadband_) {
-      // if the current temperature exceeds the target + deadband, cooling is required
-      return true;
-    } else if (this->current_temperature < temperature - this->cooling_overrun_) {
-      // if the current temperature is less than the target - overrun, cooling should stop
-      return false;
-    } else {
-      // if we get here, the current temperature is between target + deadband and target - overrun,
-      //  so the action should not change unless it conflicts with the current mode
-      return (this->action == climate::CLIMATE_ACTION_COOLING) &&
-             ((this->mode == climate::CLIMATE_MODE_HEAT_COOL) || (this->mode == climate::CLIMATE_MODE_COOL));
-    }
-  }
-  return false;
+  if (!this->supports_cool_)
+    return false;
+  // between the thresholds, the action should not change unless it conflicts with the current mode
+  bool active = (this->action == climate::CLIMATE_ACTION_COOLING) &&
+                ((this->mode == climate::CLIMATE_MODE_HEAT_COOL) || (this->mode == climate::CLIMATE_MODE_COOL));
+  return DEMAND_REQUIRED[this->zones_.cool][active];
 }
 
 bool ThermostatClimate::fanning_required_() {
-  auto temperature = this->supports_two_points_ ? this->target_temperature_high : this->target_temperature;
-
-  if (this->supports_fan_only_) {
-    if (this->supports_fan_only_cooling_) {
-      if (this->current_temperature > temperature + this->cooling_deadband_) {
-        // if the current temperature exceeds the target + deadband, fanning is required
-        return true;
-      } else if (this->current_temperature < temperature - this->cooling_overrun_) {
-        // if the current temperature is less than the target - overrun, fanning should stop
-        return false;
-      } else {
-        // if we get here, the current temperature is between target + deadband and target - overrun,
-        //  so the action should not change unless it conflicts with the current mode
-        return (this->action == climate::CLIMATE_ACTION_FAN) && (this->mode == climate::CLIMATE_MODE_FAN_ONLY);
-      }
-    } else {
-      return true;
-    }
-  }
-  return false;
+  if (!this->supports_fan_only_)
+    return false;
+  if (!this->supports_fan_only_cooling_)
+    return true;
+  // fanning uses the cooling thresholds
+  bool active = (this->action == climate::CLIMATE_ACTION_FAN) && (this->mode == climate::CLIMATE_MODE_FAN_ONLY);
+  return DEMAND_REQUIRED[this->zones_.cool][active];
 }
 
 bool ThermostatClimate::heating_required_() {
-  auto temperature = this->supports_two_points_ ? this->target_temperature_low : this->target_temperature;
-
-  if (this->supports_heat_) {
-    if (this->current_temperature < temperature - this->heating_deadband_) {
-      // if the current temperature is below the target - deadband, heating is required
-      return true;
-    } else if (this->current_temperature > temperature + this->heating_overrun_) {
-      // if the current temperature is above the target + overrun, heating should stop
-      return false;
-    } else {
-      // if we get here, the current temperature is between target - deadband and target + overrun,
-      //  so the action should not change unless it conflicts with the current mode
-      return (this->action == climate::CLIMATE_ACTION_HEATING) &&
-             ((this->mode == climate::CLIMATE_MODE_HEAT_COOL) || (this->mode == climate::CLIMATE_MODE_HEAT));
-    }
-  }
-  return false;
+  if (!this->supports_heat_)
+    return false;
+  // between the thresholds, the action should not change unless it conflicts with the current mode
+  bool active = (this->action == climate::CLIMATE_ACTION_HEATING) &&
+                ((this->mode == climate::CLIMATE_MODE_HEAT_COOL) || (this->mode == climate::CLIMATE_MODE_HEAT));
+  return DEMAND_REQUIRED[this->zones_.heat][active];
 }
 
 bool ThermostatClimate::supplemental_cooling_required_() {
-  auto temperature = this->supports_two_points_ ? this->target_temperature_high : this->target_temperature;
   // the component must supports_cool_ and the climate action must be climate::CLIMATE_ACTION_COOLING. then...
   // supplemental cooling is required if the max delta or max runtime was exceeded or the action is already engaged
   return this->supports_cool_ && (this->action == climate::CLIMATE_ACTION_COOLING) &&
-         (this->cooling_max_runtime_exceeded_ ||
-          (this->current_temperature > temperature + this->supplemental_cool_delta_) ||
+         (this->cooling_max_runtime_exceeded_ || this->zones_.supplemental_cool ||
           (this->supplemental_action_ == climate::CLIMATE_ACTION_COOLING));
 }
 
 bool ThermostatClimate::supplemental_heating_required_() {
-  auto temperature = this->supports_two_points_ ? this->target_temperature_low : this->target_temperature;
   // the component must supports_heat_ and the climate action must be climate::CLIMATE_ACTION_HEATING. then...
   // supplemental heating is required if the max delta or max runtime was exceeded or the action is already engaged
   return this->supports_heat_ && (this->action == climate::CLIMATE_ACTION_HEATING) &&
-         (this->heating_max_runtime_exceeded_ ||
-          (this->current_temperature < temperature - this->supplemental_heat_delta_) ||
+         (this->heating_max_runtime_exceeded_ || this->zones_.supplemental_heat ||
           (this->supplemental_action_ == climate::CLIMATE_ACTION_HEATING));
 }
 
@@ -969,12 +1009,30 @@ void ThermostatClimate::set_default_mode(climate::ClimateMode default_mode) { th
 void ThermostatClimate::set_set_point_minimum_differential(float differential) {
   this->set_point_minimum_differential_ = differential;
 }
-void ThermostatClimate::set_cool_deadband(float deadband) { this->cooling_deadband_ = deadband; }
-void ThermostatClimate::set_cool_overrun(float overrun) { this->cooling_overrun_ = overrun; }
-void ThermostatClimate::set_heat_deadband(float deadband) { this->heating_deadband_ = deadband; }
-void ThermostatClimate::set_heat_overrun(float overrun) { this->heating_overrun_ = overrun; }
-void ThermostatClimate::set_supplemental_cool_delta(float delta) { this->supplemental_cool_delta_ = delta; }
-void ThermostatClimate::set_supplemental_heat_delta(float delta) { this->supplemental_heat_delta_ = delta; }
+void ThermostatClimate::set_cool_deadband(float deadband) {
+  this->cooling_deadband_ = deadband;
+  this->thresholds_valid_ = false;
+}
+void ThermostatClimate::set_cool_overrun(float overrun) {
+  this->cooling_overrun_ = overrun;
+  this->thresholds_valid_ = false;
+}
+void ThermostatClimate::set_heat_deadband(float deadband) {
+  this->heating_deadband_ = deadband;
+  this->thresholds_valid_ = false;
+}
+void ThermostatClimate::set_heat_overrun(float overrun) {
+  this->heating_overrun_ = overrun;
+  this->thresholds_valid_ = false;
+}
+void ThermostatClimate::set_supplemental_cool_delta(float delta) {
+  this->supplemental_cool_delta_ = delta;
+  this->thresholds_valid_ = false;
+}
+void ThermostatClimate::set_supplemental_heat_delta(float delta) {
+  this->supplemental_heat_delta_ = delta;
+  this->thresholds_valid_ = false;
+}
 void ThermostatClimate::set_cooling_maximum_run_time_in_sec(uint32_t time) {
   this->timer_[thermostat::TIMER_COOLING_MAX_RUN_TIME].time =
       1000 * (time < this->min_timer_duration_ ? this->min_timer_duration_ : time);
@@ -43,6 +43,55 @@ struct ThermostatClimateTargetTempConfig {
   float heat_overrun_{NAN};
 };
 
+/// Where the current temperature is relative to the two thresholds of a cooling/heating demand.
+enum ThermostatDemandZone : uint8_t {
+  /// Past the overrun, the demand stops.
+  DEMAND_ZONE_OFF = 0,
+  /// Between the overrun and the deadband, the demand keeps its state.
+  DEMAND_ZONE_HOLD = 1,
+  /// Past the deadband, the demand starts.
+  DEMAND_ZONE_ON = 2,
+};
+
+/// The thresholds of all demands, derived from the (validated) set points and the hysteresis values.
+struct ThermostatClimateThresholds {
+  float cool_on{NAN};
+  float cool_off{NAN};
+  float heat_on{NAN};
+  float heat_off{NAN};
+  float supplemental_cool{NAN};
+  float supplemental_heat{NAN};
+};
+
+/// The zones the current temperature is in. Actions only depend on the temperature through these.
+struct ThermostatClimateZones {
+  bool valid{false};
+  ThermostatDemandZone cool{DEMAND_ZONE_OFF};
+  ThermostatDemandZone heat{DEMAND_ZONE_OFF};
+  bool supplemental_cool{false};
+  bool supplemental_heat{false};
+
+  bool operator==(const ThermostatClimateZones &other) const {
+    return this->valid == other.valid && this->cool == other.cool && this->heat == other.heat &&
+           this->supplemental_cool == other.supplemental_cool && this->supplemental_heat == other.supplemental_heat;
+  }
+};
+
+/// The parts of the climate state that are published, to skip publishing when nothing changed.
+struct ThermostatClimatePublishedState {
+  climate::ClimateMode mode;
+  climate::ClimateAction action;
+  optional<climate::ClimateFanMode> fan_mode;
+  climate::ClimateSwingMode swing_mode;
+  optional<climate::ClimatePreset> preset;
+  float current_temperature;
+  float target_temperature;
+  float target_temperature_low;
+  float target_temperature_high;
+
+  bool operator==(const ThermostatClimatePublishedState &other) const;
+};
+
 class ThermostatClimate : public climate::Climate, public Component {
  public:
   ThermostatClimate();
@@ -158,6 +207,16 @@ class ThermostatClimate : public climate::Climate, public Component {
   /// Re-compute the required action of this climate controller.
   climate::ClimateAction compute_action_(bool ignore_timers = false);
   climate::ClimateAction compute_supplemental_action_();
+  /// Switch to the computed actions and remember if a transition is still pending.
+  void update_actions_();
+
+  /// Recompute the thresholds if the set points changed since they were last computed.
+  void update_thresholds_();
+  /// Recompute the zones of the current temperature; returns true if any of them changed.
+  bool update_zones_();
+
+  /// Publish the state, unless it's the same as the last published state.
+  void publish_state_if_changed_();
 
   /// Switch the climate device to the given climate action.
   void switch_to_action_(climate::ClimateAction action, bool publish_state = true);
@@ -276,6 +335,13 @@ class ThermostatClimate : public climate::Climate, public Component {
   bool cooling_max_runtime_exceeded_{false};
   bool heating_max_runtime_exceeded_{false};
 
+  /// Set when the computed action or supplemental action could not be switched to yet (for example, it must
+  /// first go through idle or a timer is running), so it's recomputed on the next sensor update
+  bool transition_pending_{true};
+
+  /// Set once the state was published; published_state_ is only valid after that
+  bool state_published_{false};
+
   /// Used to start "off" delay timers at boot
   bool use_startup_delay_{false};
 
@@ -393,6 +459,19 @@ class ThermostatClimate : public climate::Climate, public Component {
   float prev_target_temperature_low_{NAN};
   float prev_target_temperature_high_{NAN};
 
+  /// The set points the thresholds were computed from; thresholds_valid_ is cleared when the hysteresis changes
+  bool thresholds_valid_{false};
+  float thresholds_target_temperature_{NAN};
+  float thresholds_target_temperature_low_{NAN};
+  float thresholds_target_temperature_high_{NAN};
+
+  /// Demand thresholds and the zones the current temperature was last found in
+  ThermostatClimateThresholds thresholds_{};
+  ThermostatClimateZones zones_{};
+
+  /// The last published state
+  ThermostatClimatePublishedState published_state_{};
+
   /// Minimum differential required between set points
   float set_point_minimum_differential_{0};
 
@@ -1,12 +1,9 @@
 #include "automation.h"
 #include "esphome/core/log.h"
-#include <cinttypes>
 
 namespace esphome {
 namespace time {
 
-static const char *const TAG = "automation";
-
 void CronTrigger::add_second(uint8_t second) { this->seconds_[second] = true; }
 void CronTrigger::add_minute(uint8_t minute) { this->minutes_[minute] = true; }
 void CronTrigger::add_hour(uint8_t hour) { this->hours_[hour] = true; }
@@ -17,42 +14,72 @@ bool CronTrigger::matches(const ESPTime &time) {
   return time.is_valid() && this->seconds_[time.second] && this->minutes_[time.minute] && this->hours_[time.hour] &&
          this->days_of_month_[time.day_of_month] && this->months_[time.month] && this->days_of_week_[time.day_of_week];
 }
-void CronTrigger::loop() {
-  ESPTime time = this->rtc_->now();
-  if (!time.is_valid())
-    return;
-
-  if (this->last_check_.has_value()) {
-    if (*this->last_check_ > time && this->last_check_->timestamp - time.timestamp > 900) {
-      // We went back in time (a lot), probably caused by time synchronization
-      ESP_LOGW(TAG, "Time has jumped back!");
-    } else if (*this->last_check_ >= time) {
-      // already handled this one
-      return;
-    }
-
-    while (true) {
-      this->last_check_->increment_second();
-      if (*this->last_check_ >= time)
-        break;
-
-      if (this->matches(*this->last_check_))
-        this->trigger();
+bool CronTrigger::next_time_of_day_(uint8_t *hour, uint8_t *minute, uint8_t *second) {
+  for (uint8_t h = *hour; h < 24; h++) {
+    if (!this->hours_[h])
+      continue;
+    for (uint8_t m = h == *hour ? *minute : 0; m < 60; m++) {
+      if (!this->minutes_[m])
+        continue;
+      // Leap seconds are never reported, so second 60 doesn't match
+      for (uint8_t s = h == *hour && m == *minute ? *second : 0; s < 60; s++) {
+        if (!this->seconds_[s])
+          continue;
+        *hour = h;
+        *minute = m;
+        *second = s;
+        return true;
+      }
     }
   }
+  return false;
+}
+optional<time_t> CronTrigger::next_match(const ESPTime &now) {
+  if (!now.is_valid())
+    return {};
 
-  this->last_check_ = time;
-  if (!time.fields_in_range()) {
-    ESP_LOGW(TAG, "Time is out of range!");
-    ESP_LOGD(TAG, "Second=%02u Minute=%02u Hour=%02u DayOfWeek=%u DayOfMonth=%u DayOfYear=%u Month=%u time=%" PRId64,
-             time.second, time.minute, time.hour, time.day_of_week, time.day_of_month, time.day_of_year, time.month,
-             (int64_t) time.timestamp);
+  // Before DST ends, the second occurrence of the local times it repeats is found by the search below
+  optional<time_t> next = this->next_match_from_(now, now.timestamp, !now.is_dst);
+  // When DST ends within the next hour, local times from an hour ago occur again
+  if (now.is_dst && !ESPTime::from_epoch_local(now.timestamp + 3600).is_dst) {
+    ESPTime hour_ago = ESPTime::from_epoch_local(now.timestamp - 3600);
+    optional<time_t> repeated = this->next_match_from_(hour_ago, now.timestamp, true);
+    if (repeated.has_value() && (!next.has_value() || *repeated < *next))
+      next = repeated;
   }
-
-  if (this->matches(time))
-    this->trigger();
+  return next;
+}
+optional<time_t> CronTrigger::next_match_from_(ESPTime day, time_t after, bool allow_repeated) {
+  uint8_t hour = day.hour, minute = day.minute, second = day.second;
+  // Every combination of day of month, month and day of week occurs within 28 years
+  for (uint32_t i = 0; i < 28 * 366; i++) {
+    if (this->days_of_month_[day.day_of_month] && this->months_[day.month] && this->days_of_week_[day.day_of_week]) {
+      while (this->next_time_of_day_(&hour, &minute, &second)) {
+        // A local time occurs twice when DST ends, try the earlier one with DST first
+        for (int is_dst = 1; is_dst >= 0; is_dst--) {
+          struct tm c_tm = day.to_c_tm();
+          c_tm.tm_hour = hour;
+          c_tm.tm_min = minute;
+          c_tm.tm_sec = second;
+          c_tm.tm_isdst = is_dst;
+          time_t timestamp = ::mktime(&c_tm);
+          // mktime() moves times that don't exist with this DST flag, like those skipped when DST starts
+          if (c_tm.tm_mday != day.day_of_month || c_tm.tm_hour != hour || c_tm.tm_min != minute)
+            continue;
+          if (timestamp > after)
+            return timestamp;
+          if (!allow_repeated)
+            break;
+        }
+        second++;
+      }
+    }
+    day.increment_day();
+    hour = minute = second = 0;
+  }
+  return {};
 }
-CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) {}
+CronTrigger::CronTrigger(RealTimeClock *rtc) : rtc_(rtc) { rtc->add_cron_trigger(this); }
 void CronTrigger::add_seconds(const std::vector<uint8_t> &seconds) {
   for (uint8_t it : seconds)
     this->add_second(it);
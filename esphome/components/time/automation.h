@@ -23,10 +23,20 @@ class CronTrigger : public Trigger<>, public Component {
   void add_day_of_week(uint8_t day_of_week);
   void add_days_of_week(const std::vector<uint8_t> &days_of_week);
   bool matches(const ESPTime &time);
-  void loop() override;
+  /// The timestamp of the first time after now that matches, if there is one.
+  optional<time_t> next_match(const ESPTime &now);
   float get_setup_priority() const override;
 
  protected:
+  /// Find the first matching hour, minute and second at or after the given ones on a matching day.
+  bool next_time_of_day_(uint8_t *hour, uint8_t *minute, uint8_t *second);
+  /** The first matching time after the timestamp after, searching from the local time of day on.
+   *
+   * @param allow_repeated Whether to return the second occurrence of a local time repeated when DST ends, even though
+   * the first one has passed already.
+   */
+  optional<time_t> next_match_from_(ESPTime day, time_t after, bool allow_repeated);
+
   std::bitset<61> seconds_;
   std::bitset<60> minutes_;
   std::bitset<24> hours_;
@@ -34,7 +44,6 @@ class CronTrigger : public Trigger<>, public Component {
   std::bitset<13> months_;
   std::bitset<8> days_of_week_;
   RealTimeClock *rtc_;
-  optional<ESPTime> last_check_;
 };
 
 class SyncTrigger : public Trigger<>, public Component {
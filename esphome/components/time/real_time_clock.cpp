@@ -1,9 +1,11 @@
 #include "real_time_clock.h"
+#include "automation.h"
 #include "esphome/core/log.h"
 #include "lwip/opt.h"
 #ifdef USE_ESP8266
 #include "sys/time.h"
 #endif
+#include <algorithm>
 #include <cerrno>
 
 namespace esphome {
@@ -11,11 +13,45 @@ namespace time {
 
 static const char *const TAG = "time";
 
+/// The longest time in seconds to wait before checking the cron triggers again.
+static const time_t MAX_CRON_WAIT = 3600;
+
 RealTimeClock::RealTimeClock() = default;
 void RealTimeClock::call_setup() {
   setenv("TZ", this->timezone_.c_str(), 1);
   tzset();
   PollingComponent::call_setup();
+  if (!this->cron_triggers_.empty()) {
+    this->add_on_time_sync_callback([this]() { this->process_cron_triggers_(true); });
+    this->process_cron_triggers_(true);
+  }
+}
+void RealTimeClock::process_cron_triggers_(bool time_changed) {
+  ESPTime now = this->now();
+  if (!now.is_valid()) {
+    // Wait for the time to be set, some clocks keep it without a synchronization
+    this->set_timeout("cron", 1000, [this]() { this->process_cron_triggers_(true); });
+    return;
+  }
+
+  time_t next = now.timestamp + MAX_CRON_WAIT;
+  for (auto &entry : this->cron_triggers_) {
+    if (entry.next != 0 && entry.next <= now.timestamp) {
+      // Fired once even if the time jumped over several matches
+      entry.trigger->trigger();
+      entry.next = 0;
+    }
+    if (entry.next == 0 || time_changed)
+      entry.next = entry.trigger->next_match(now).value_or(0);
+    if (entry.next != 0)
+      next = std::min(next, entry.next);
+  }
+
+  // Fire right after the second starts
+  struct timeval tv {};
+  ::gettimeofday(&tv, nullptr);
+  int64_t delay = int64_t(next - tv.tv_sec) * 1000 - tv.tv_usec / 1000;
+  this->set_timeout("cron", std::max<int64_t>(delay, 0), [this]() { this->process_cron_triggers_(false); });
 }
 void RealTimeClock::synchronize_epoch_(uint32_t epoch) {
   struct timeval timev {
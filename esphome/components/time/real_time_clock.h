@@ -99,6 +99,8 @@ struct ESPTime {
   bool operator>(ESPTime other);
 };
 
+class CronTrigger;
+
 /// The RealTimeClock class exposes common timekeeping functions via the device's local real-time clock.
 ///
 /// \note
@@ -130,11 +132,26 @@ class RealTimeClock : public PollingComponent {
     this->time_sync_callback_.add(std::move(callback));
   };
 
+  /// Fire a CronTrigger at the times it matches. All triggers of a clock share a single timeout.
+  void add_cron_trigger(CronTrigger *trigger) { this->cron_triggers_.push_back(CronEntry{trigger, 0}); }
+
  protected:
   /// Report a unix epoch as current time.
   void synchronize_epoch_(uint32_t epoch);
+  /** Fire the due cron triggers and schedule the timeout for the next one.
+   *
+   * @param time_changed Whether the time was just set, so all fire times have to be recalculated.
+   */
+  void process_cron_triggers_(bool time_changed);
+
+  struct CronEntry {
+    CronTrigger *trigger;
+    /// The next time the trigger matches, or 0 if unknown.
+    time_t next;
+  };
 
   std::string timezone_{};
+  std::vector<CronEntry> cron_triggers_;
 
   CallbackManager<void()> time_sync_callback_;
 };
@@ -13,8 +13,10 @@ from esphome.const import (
     CONF_ACCURACY_DECIMALS,
 )
 from esphome.core.entity_helpers import inherit_property_from
+from esphome.components.integration import get_accumulator_store
 
 DEPENDENCIES = ["time"]
+AUTO_LOAD = ["integration"]
 
 CONF_POWER_ID = "power_id"
 CONF_MIN_SAVE_INTERVAL = "min_save_interval"
@@ -38,6 +40,8 @@ def inherit_accuracy_decimals(decimals, config):
     return decimals + 2
 
 
+# The source sensor's values are integrated in fixed point: they are limited to
+# +-4194304 and rounded to 1/65536, values outside of that are logged once.
 CONFIG_SCHEMA = (
     sensor.sensor_schema(
         TotalDailyEnergy,
@@ -89,6 +93,7 @@ async def to_code(config):
     cg.add(var.set_parent(sens))
     time_ = await cg.get_variable(config[CONF_TIME_ID])
     cg.add(var.set_time(time_))
-    cg.add(var.set_restore(config[CONF_RESTORE]))
-    cg.add(var.set_min_save_interval(config[CONF_MIN_SAVE_INTERVAL]))
+    if config[CONF_RESTORE]:
+        store = await get_accumulator_store()
+        cg.add(var.set_store(store, config[CONF_MIN_SAVE_INTERVAL]))
     cg.add(var.set_method(config[CONF_METHOD]))
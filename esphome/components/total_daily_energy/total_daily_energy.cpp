@@ -7,18 +7,33 @@ namespace total_daily_energy {
 static const char *const TAG = "total_daily_energy";
 
 void TotalDailyEnergy::setup() {
-  float initial_value = 0;
+  // Power in W integrated over hours
+  this->accumulator_.set_time_unit(3600000);
+  if (this->store_ != nullptr)
+    this->store_->restore(&this->accumulator_);
+  this->accumulator_.start(millis());
+  this->publish_state(this->accumulator_.get_total());
 
-  if (this->restore_) {
-    this->pref_ = global_preferences->make_preference<float>(this->get_object_id_hash());
-    this->pref_.load(&initial_value);
-  }
-  this->publish_state_and_save(initial_value);
+  this->parent_->add_on_state_callback([this](float state) { this->process_new_state_(state); });
+}
 
-  this->last_update_ = millis();
-  this->last_save_ = this->last_update_;
+void TotalDailyEnergy::set_store(integration::AccumulatorStore *store, uint32_t min_save_interval) {
+  this->store_ = store;
+  store->add(this->get_object_id_hash(), &this->accumulator_, min_save_interval);
+}
 
-  this->parent_->add_on_state_callback([this](float state) { this->process_new_state_(state); });
+void TotalDailyEnergy::set_method(TotalDailyEnergyMethod method) {
+  switch (method) {
+    case TOTAL_DAILY_ENERGY_METHOD_TRAPEZOID:
+      this->accumulator_.set_method(integration::INTEGRATION_METHOD_TRAPEZOID);
+      break;
+    case TOTAL_DAILY_ENERGY_METHOD_LEFT:
+      this->accumulator_.set_method(integration::INTEGRATION_METHOD_LEFT);
+      break;
+    case TOTAL_DAILY_ENERGY_METHOD_RIGHT:
+      this->accumulator_.set_method(integration::INTEGRATION_METHOD_RIGHT);
+      break;
+  }
 }
 
 void TotalDailyEnergy::dump_config() { LOG_SENSOR("", "Total Daily Energy", this); }
@@ -35,44 +50,26 @@ void TotalDailyEnergy::loop() {
 
   if (t.day_of_year != this->last_day_of_year_) {
     this->last_day_of_year_ = t.day_of_year;
-    this->total_energy_ = 0;
     this->publish_state_and_save(0);
   }
 }
 
 void TotalDailyEnergy::publish_state_and_save(float state) {
-  this->total_energy_ = state;
-  this->publish_state(state);
-  const uint32_t now = millis();
-  if (now - this->last_save_ < this->min_save_interval_) {
-    return;
-  }
-  this->last_save_ = now;
-  this->pref_.save(&state);
+  this->accumulator_.set_total(state);
+  this->publish_and_save_();
+}
+
+void TotalDailyEnergy::publish_and_save_() {
+  this->publish_state(this->accumulator_.get_total());
+  if (this->store_ != nullptr)
+    this->store_->mark_dirty();
 }
 
 void TotalDailyEnergy::process_new_state_(float state) {
   if (std::isnan(state))
     return;
-  const uint32_t now = millis();
-  const float old_state = this->last_power_state_;
-  const float new_state = state;
-  float delta_hours = (now - this->last_update_) / 1000.0f / 60.0f / 60.0f;
-  float delta_energy = 0.0f;
-  switch (this->method_) {
-    case TOTAL_DAILY_ENERGY_METHOD_TRAPEZOID:
-      delta_energy = delta_hours * (old_state + new_state) / 2.0;
-      break;
-    case TOTAL_DAILY_ENERGY_METHOD_LEFT:
-      delta_energy = delta_hours * old_state;
-      break;
-    case TOTAL_DAILY_ENERGY_METHOD_RIGHT:
-      delta_energy = delta_hours * new_state;
-      break;
-  }
-  this->last_power_state_ = new_state;
-  this->last_update_ = now;
-  this->publish_state_and_save(this->total_energy_ + delta_energy);
+  this->accumulator_.add_sample(millis(), state);
+  this->publish_and_save_();
 }
 
 }  // namespace total_daily_energy
@@ -5,6 +5,7 @@
 #include "esphome/core/hal.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/components/time/real_time_clock.h"
+#include "esphome/components/integration/accumulator.h"
 
 namespace esphome {
 namespace total_daily_energy {
@@ -17,11 +18,11 @@ enum TotalDailyEnergyMethod {
 
 class TotalDailyEnergy : public sensor::Sensor, public Component {
  public:
-  void set_restore(bool restore) { restore_ = restore; }
-  void set_min_save_interval(uint32_t min_interval) { this->min_save_interval_ = min_interval; }
+  /// Restore the total from and save it to store, at most once per min_save_interval ms.
+  void set_store(integration::AccumulatorStore *store, uint32_t min_save_interval);
   void set_time(time::RealTimeClock *time) { time_ = time; }
   void set_parent(Sensor *parent) { parent_ = parent; }
-  void set_method(TotalDailyEnergyMethod method) { method_ = method; }
+  void set_method(TotalDailyEnergyMethod method);
   void setup() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -31,18 +32,13 @@ class TotalDailyEnergy : public sensor::Sensor, public Component {
 
  protected:
   void process_new_state_(float state);
+  void publish_and_save_();
 
-  ESPPreferenceObject pref_;
+  integration::Accumulator accumulator_;
+  integration::AccumulatorStore *store_{nullptr};
   time::RealTimeClock *time_;
   Sensor *parent_;
-  TotalDailyEnergyMethod method_;
   uint16_t last_day_of_year_{};
-  uint32_t last_update_{0};
-  uint32_t last_save_{0};
-  uint32_t min_save_interval_{0};
-  bool restore_;
-  float total_energy_{0.0f};
-  float last_power_state_{0.0f};
 };
 
 }  // namespace total_daily_energy
@@ -10,18 +10,38 @@ namespace tuya {
 static const char *const TAG = "tuya";
 static const int COMMAND_DELAY = 10;
 static const int RECEIVE_TIMEOUT = 300;
+/// Maximum payload of a DATAPOINT_DELIVER command with updates of multiple datapoints.
+static const size_t MAX_BATCH_PAYLOAD = 256;
 
 void Tuya::setup() {
+  // CHECKSUM: sum of all bytes (including header) modulo 256
+  this->rx_frames_.set_checksum([](const uint8_t *data, size_t len) {
+    uint8_t calc_checksum = 0;
+    for (size_t i = 0; i < len - 1; i++)
+      calc_checksum += data[i];
+    if (data[len - 1] != calc_checksum) {
+      ESP_LOGW(TAG, "Tuya Received invalid message checksum %02X!=%02X", data[len - 1], calc_checksum);
+      return false;
+    }
+    return true;
+  });
   this->set_interval("heartbeat", 15000, [this] { this->send_empty_command_(TuyaCommandType::HEARTBEAT); });
 }
 
 void Tuya::loop() {
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    this->handle_char_(c);
+  uint32_t now = millis();
+  if (this->rx_frames_.read_from(this) != 0) {
+    this->last_rx_char_timestamp_ = now;
+  } else if (this->rx_frames_.size() != 0 && now - this->last_rx_char_timestamp_ > RECEIVE_TIMEOUT) {
+    // Drop an incomplete frame
+    this->rx_frames_.clear();
   }
-  process_command_queue_();
+
+  const uint8_t *frame;
+  size_t len;
+  while (this->rx_frames_.next_frame(&frame, &len))
+    this->handle_frame_(frame, len);
+  this->process_command_queue_();
 }
 
 void Tuya::dump_config() {
@@ -54,72 +74,23 @@ void Tuya::dump_config() {
                   this->gpio_reset_);
   }
   ESP_LOGCONFIG(TAG, "  Product: '%s'", this->product_.c_str());
+  ESP_LOGCONFIG(TAG, "  Batch datapoints: %s", YESNO(this->batch_datapoints_));
+  if (this->latency_count_ != 0) {
+    ESP_LOGCONFIG(TAG, "  Command latency: average %ums, maximum %ums over %u commands",
+                  this->latency_total_ / this->latency_count_, this->latency_max_, this->latency_count_);
+  }
   this->check_uart_settings(9600);
 }
 
-bool Tuya::validate_message_() {
-  uint32_t at = this->rx_message_.size() - 1;
-  auto *data = &this->rx_message_[0];
-  uint8_t new_byte = data[at];
-
-  // Byte 0: HEADER1 (always 0x55)
-  if (at == 0)
-    return new_byte == 0x55;
-  // Byte 1: HEADER2 (always 0xAA)
-  if (at == 1)
-    return new_byte == 0xAA;
-
-  // Byte 2: VERSION
-  // no validation for the following fields:
-  uint8_t version = data[2];
-  if (at == 2)
-    return true;
-  // Byte 3: COMMAND
-  uint8_t command = data[3];
-  if (at == 3)
-    return true;
-
-  // Byte 4: LENGTH1
-  // Byte 5: LENGTH2
-  if (at <= 5) {
-    // no validation for these fields
-    return true;
-  }
-
-  uint16_t length = (uint16_t(data[4]) << 8) | (uint16_t(data[5]));
-
-  // wait until all data is read
-  if (at - 6 < length)
-    return true;
-
-  // Byte 6+LEN: CHECKSUM - sum of all bytes (including header) modulo 256
-  uint8_t rx_checksum = new_byte;
-  uint8_t calc_checksum = 0;
-  for (uint32_t i = 0; i < 6 + length; i++)
-    calc_checksum += data[i];
-
-  if (rx_checksum != calc_checksum) {
-    ESP_LOGW(TAG, "Tuya Received invalid message checksum %02X!=%02X", rx_checksum, calc_checksum);
-    return false;
-  }
-
-  // valid message
-  const uint8_t *message_data = data + 6;
+void Tuya::handle_frame_(const uint8_t *frame, size_t len) {
+  // Byte 0-1: HEADER (always 0x55 0xAA), byte 4-5: LENGTH, last byte: CHECKSUM, all checked by rx_frames_
+  uint8_t version = frame[2];
+  uint8_t command = frame[3];
+  const uint8_t *message_data = frame + 6;
+  size_t length = len - 7;
   ESP_LOGV(TAG, "Received Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", command, version,
            format_hex_pretty(message_data, length).c_str(), static_cast<uint8_t>(this->init_state_));
   this->handle_command_(command, version, message_data, length);
-
-  // return false to reset rx buffer
-  return false;
-}
-
-void Tuya::handle_char_(uint8_t c) {
-  this->rx_message_.push_back(c);
-  if (!this->validate_message_()) {
-    this->rx_message_.clear();
-  } else {
-    this->last_rx_char_timestamp_ = millis();
-  }
 }
 
 void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len) {
@@ -127,6 +98,11 @@ void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buff
 
   if (this->expected_response_.has_value() && this->expected_response_ == command_type) {
     this->expected_response_.reset();
+    uint32_t latency = millis() - this->expected_queued_at_;
+    ESP_LOGV(TAG, "Response 0x%02X after %ums", command, latency);
+    this->latency_count_++;
+    this->latency_total_ += latency;
+    this->latency_max_ = std::max(this->latency_max_, latency);
   }
 
   switch (command_type) {
@@ -355,33 +331,33 @@ void Tuya::send_raw_command_(TuyaCommand command) {
       break;
   }
 
+  this->expected_queued_at_ = command.queued_at;
+
   ESP_LOGV(TAG, "Sending Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", static_cast<uint8_t>(command.cmd),
            version, format_hex_pretty(command.payload).c_str(), static_cast<uint8_t>(this->init_state_));
 
-  this->write_array({0x55, 0xAA, version, (uint8_t) command.cmd, len_hi, len_lo});
-  if (!command.payload.empty())
-    this->write_array(command.payload.data(), command.payload.size());
-
-  uint8_t checksum = 0x55 + 0xAA + (uint8_t) command.cmd + len_hi + len_lo;
-  for (auto &data : command.payload)
+  // Write the frame at once
+  std::vector<uint8_t> frame;
+  frame.reserve(command.payload.size() + 7);
+  frame.insert(frame.end(), {0x55, 0xAA, version, (uint8_t) command.cmd, len_hi, len_lo});
+  frame.insert(frame.end(), command.payload.begin(), command.payload.end());
+  uint8_t checksum = 0;
+  for (auto &data : frame)
     checksum += data;
-  this->write_byte(checksum);
+  frame.push_back(checksum);
+  this->write_array(frame);
 }
 
 void Tuya::process_command_queue_() {
   uint32_t now = millis();
   uint32_t delay = now - this->last_command_timestamp_;
 
-  if (now - this->last_rx_char_timestamp_ > RECEIVE_TIMEOUT) {
-    this->rx_message_.clear();
-  }
-
   if (this->expected_response_.has_value() && delay > RECEIVE_TIMEOUT) {
     this->expected_response_.reset();
   }
 
   // Left check of delay since last command in case there's ever a command sent by calling send_raw_command_ directly
-  if (delay > COMMAND_DELAY && !this->command_queue_.empty() && this->rx_message_.empty() &&
+  if (delay > COMMAND_DELAY && !this->command_queue_.empty() && this->rx_frames_.size() == 0 &&
       !this->expected_response_.has_value()) {
     this->send_raw_command_(command_queue_.front());
     this->command_queue_.erase(command_queue_.begin());
@@ -390,6 +366,7 @@ void Tuya::process_command_queue_() {
 
 void Tuya::send_command_(const TuyaCommand &command) {
   command_queue_.push_back(command);
+  command_queue_.back().queued_at = millis();
   process_command_queue_();
 }
 
@@ -514,6 +491,7 @@ void Tuya::set_numeric_datapoint_value_(uint8_t datapoint_id, TuyaDatapointType
     return;
   } else if (!forced && datapoint->value_uint == value) {
     ESP_LOGV(TAG, "Not sending unchanged value");
+    this->erase_queued_datapoint_(datapoint_id);
     return;
   }
 
@@ -544,6 +522,7 @@ void Tuya::set_raw_datapoint_value_(uint8_t datapoint_id, const std::vector<uint
     return;
   } else if (!forced && datapoint->value_raw == value) {
     ESP_LOGV(TAG, "Not sending unchanged value");
+    this->erase_queued_datapoint_(datapoint_id);
     return;
   }
   this->send_datapoint_command_(datapoint_id, TuyaDatapointType::RAW, value);
@@ -559,6 +538,7 @@ void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &
     return;
   } else if (!forced && datapoint->value_string == value) {
     ESP_LOGV(TAG, "Not sending unchanged value");
+    this->erase_queued_datapoint_(datapoint_id);
     return;
   }
   std::vector<uint8_t> data;
@@ -568,6 +548,32 @@ void Tuya::set_string_datapoint_value_(uint8_t datapoint_id, const std::string &
   this->send_datapoint_command_(datapoint_id, TuyaDatapointType::STRING, data);
 }
 
+void Tuya::erase_queued_datapoint_(uint8_t datapoint_id) {
+  for (auto command = this->command_queue_.begin(); command != this->command_queue_.end();) {
+    if (command->cmd != TuyaCommandType::DATAPOINT_DELIVER) {
+      ++command;
+      continue;
+    }
+    // The payload is a list of datapoints, each one is id, type, 16 bit length and data
+    auto &payload = command->payload;
+    size_t at = 0;
+    while (at + 4 <= payload.size()) {
+      size_t entry_len = 4 + ((payload[at + 2] << 8) | payload[at + 3]);
+      if (payload[at] == datapoint_id) {
+        ESP_LOGV(TAG, "Dropping queued update of datapoint %u", datapoint_id);
+        payload.erase(payload.begin() + at, payload.begin() + std::min(at + entry_len, payload.size()));
+      } else {
+        at += entry_len;
+      }
+    }
+    if (payload.empty()) {
+      command = this->command_queue_.erase(command);
+    } else {
+      ++command;
+    }
+  }
+}
+
 void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datapoint_type, std::vector<uint8_t> data) {
   std::vector<uint8_t> buffer;
   buffer.push_back(datapoint_id);
@@ -576,6 +582,20 @@ void Tuya::send_datapoint_command_(uint8_t datapoint_id, TuyaDatapointType datap
   buffer.push_back(data.size() >> 0);
   buffer.insert(buffer.end(), data.begin(), data.end());
 
+  // Only the last value matters
+  this->erase_queued_datapoint_(datapoint_id);
+
+  if (this->batch_datapoints_) {
+    for (auto &command : this->command_queue_) {
+      if (command.cmd != TuyaCommandType::DATAPOINT_DELIVER ||
+          command.payload.size() + buffer.size() > MAX_BATCH_PAYLOAD)
+        continue;
+      command.payload.insert(command.payload.end(), buffer.begin(), buffer.end());
+      this->process_command_queue_();
+      return;
+    }
+  }
+
   this->send_command_(TuyaCommand{.cmd = TuyaCommandType::DATAPOINT_DELIVER, .payload = buffer});
 }
 
@@ -4,6 +4,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
+#include "esphome/components/uart/uart_frame.h"
 
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
@@ -67,6 +68,8 @@ enum class TuyaInitState : uint8_t {
 struct TuyaCommand {
   TuyaCommandType cmd;
   std::vector<uint8_t> payload;
+  /// The time the command was queued at, for the latency statistics.
+  uint32_t queued_at{0};
 };
 
 class Tuya : public Component, public uart::UARTDevice {
@@ -98,12 +101,18 @@ class Tuya : public Component, public uart::UARTDevice {
   void add_on_initialized_callback(std::function<void()> callback) {
     this->initialized_callback_.add(std::move(callback));
   }
+  /** Set whether updates of multiple datapoints may be sent in a single DATAPOINT_DELIVER command.
+   *
+   * The protocol allows it, but not every MCU handles it, so this is disabled by default.
+   */
+  void set_batch_datapoints(bool batch_datapoints) { this->batch_datapoints_ = batch_datapoints; }
 
  protected:
-  void handle_char_(uint8_t c);
+  void handle_frame_(const uint8_t *frame, size_t len);
   void handle_datapoints_(const uint8_t *buffer, size_t len);
   optional<TuyaDatapoint> get_datapoint_(uint8_t datapoint_id);
-  bool validate_message_();
+  /// Remove the queued updates of a datapoint that haven't been sent to the MCU yet.
+  void erase_queued_datapoint_(uint8_t datapoint_id);
 
   void handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len);
   void send_raw_command_(TuyaCommand command);
@@ -130,10 +139,18 @@ class Tuya : public Component, public uart::UARTDevice {
   std::string product_ = "";
   std::vector<TuyaDatapointListener> listeners_;
   std::vector<TuyaDatapoint> datapoints_;
-  std::vector<uint8_t> rx_message_;
+  /// Frames are 55 AA, version, command, 16 bit length, data and checksum.
+  uart::LengthFrameExtractor rx_frames_{std::vector<uint8_t>{0x55, 0xAA}, 4, 2, 7, 1024};
   std::vector<uint8_t> ignore_mcu_update_on_datapoints_{};
   std::vector<TuyaCommand> command_queue_;
   optional<TuyaCommandType> expected_response_{};
+  bool batch_datapoints_{false};
+  /// The time the command waiting for expected_response_ was queued at.
+  uint32_t expected_queued_at_{0};
+  /// Time in milliseconds from queueing a command until the MCU responded to it.
+  uint32_t latency_count_{0};
+  uint32_t latency_total_{0};
+  uint32_t latency_max_{0};
   uint8_t wifi_status_ = -1;
   CallbackManager<void()> initialized_callback_{};
 };
@@ -102,6 +102,17 @@ UART_PARITY_OPTIONS = {
 CONF_STOP_BITS = "stop_bits"
 CONF_DATA_BITS = "data_bits"
 CONF_PARITY = "parity"
+CONF_RX_IDLE_TIMEOUT = "rx_idle_timeout"
+CONF_RX_PATTERN = "rx_pattern"
+
+
+def validate_rx_pattern(value):
+    if isinstance(value, str):
+        if len(value) != 1:
+            raise cv.Invalid("The RX pattern must be a single character or byte")
+        return ord(value)
+    return cv.hex_uint8_t(value)
+
 
 UARTDirection = uart_ns.enum("UARTDirection")
 UART_DIRECTIONS = {
@@ -173,6 +184,12 @@ CONFIG_SCHEMA = cv.All(
                 "This option has been removed. Please instead use invert in the tx/rx pin schemas."
             ),
             cv.Optional(CONF_DEBUG): maybe_empty_debug,
+            cv.Optional(CONF_RX_IDLE_TIMEOUT): cv.All(
+                cv.only_with_esp_idf, cv.int_range(min=1, max=126)
+            ),
+            cv.Optional(CONF_RX_PATTERN): cv.All(
+                cv.only_with_esp_idf, validate_rx_pattern
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     cv.has_at_least_one_key(CONF_TX_PIN, CONF_RX_PIN),
@@ -222,6 +239,10 @@ async def to_code(config):
     cg.add(var.set_stop_bits(config[CONF_STOP_BITS]))
     cg.add(var.set_data_bits(config[CONF_DATA_BITS]))
     cg.add(var.set_parity(config[CONF_PARITY]))
+    if CONF_RX_IDLE_TIMEOUT in config:
+        cg.add(var.set_rx_idle_timeout(config[CONF_RX_IDLE_TIMEOUT]))
+    if CONF_RX_PATTERN in config:
+        cg.add(var.set_rx_pattern(config[CONF_RX_PATTERN]))
 
     if CONF_DEBUG in config:
         await debug_to_code(config[CONF_DEBUG], var)
@@ -1,4 +1,5 @@
 #include "uart_component.h"
+#include <algorithm>
 
 namespace esphome {
 namespace uart {
@@ -20,5 +21,15 @@ bool UARTComponent::check_read_timeout_(size_t len) {
   return true;
 }
 
+size_t UARTComponent::read_available(uint8_t *data, size_t max_len) {
+  int available = this->available();
+  if (available <= 0 || max_len == 0)
+    return 0;
+  size_t len = std::min(size_t(available), max_len);
+  if (!this->read_array(data, len))
+    return 0;
+  return len;
+}
+
 }  // namespace uart
 }  // namespace esphome
@@ -5,6 +5,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #ifdef USE_UART_DEBUGGER
 #include "esphome/core/automation.h"
@@ -43,6 +44,13 @@ class UARTComponent {
   bool read_byte(uint8_t *data) { return this->read_array(data, 1); };
   virtual bool peek_byte(uint8_t *data) = 0;
   virtual bool read_array(uint8_t *data, size_t len) = 0;
+  /** Read up to max_len bytes that were already received, without waiting for more.
+   *
+   * Use this instead of calling read_byte() for every available byte.
+   *
+   * @return The number of bytes read.
+   */
+  size_t read_available(uint8_t *data, size_t max_len);
 
   /// Return available number of bytes.
   virtual int available() = 0;
@@ -63,6 +71,15 @@ class UARTComponent {
   void set_baud_rate(uint32_t baud_rate) { baud_rate_ = baud_rate; }
   uint32_t get_baud_rate() const { return baud_rate_; }
 
+  /** Add a callback that is called from the main loop when the UART driver reports the end of a received frame.
+   *
+   * That happens when the RX line was idle for the configured RX idle timeout, or when the configured RX pattern byte
+   * was received. Only backends with RX events (ESP-IDF) call it, everywhere else the data has to be polled.
+   */
+  void add_on_rx_frame_callback(std::function<void()> &&callback) {
+    this->rx_frame_callback_.add(std::move(callback));
+  }
+
 #ifdef USE_UART_DEBUGGER
   void add_debug_callback(std::function<void(UARTDirection, uint8_t)> &&callback) {
     this->debug_callback_.add(std::move(callback));
@@ -80,6 +97,7 @@ class UARTComponent {
   uint8_t stop_bits_;
   uint8_t data_bits_;
   UARTParityOptions parity_;
+  CallbackManager<void()> rx_frame_callback_{};
 #ifdef USE_UART_DEBUGGER
   CallbackManager<void(UARTDirection, uint8_t)> debug_callback_{};
 #endif
@@ -79,13 +79,43 @@ void IDFUARTComponent::setup() {
     return;
   }
 
-  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, 0, nullptr, 0);
+  bool rx_events = this->rx_pin_ != nullptr && (this->rx_idle_timeout_ != 0 || this->has_rx_pattern_);
+  err = uart_driver_install(this->uart_num_, this->rx_buffer_size_, 0, rx_events ? 20 : 0,
+                            rx_events ? &this->event_queue_ : nullptr, 0);
   if (err != ESP_OK) {
     ESP_LOGW(TAG, "uart_driver_install failed: %s", esp_err_to_name(err));
     this->mark_failed();
     return;
   }
 
+  if (this->rx_idle_timeout_ != 0) {
+    err = uart_set_rx_timeout(this->uart_num_, this->rx_idle_timeout_);
+    if (err != ESP_OK) {
+      ESP_LOGW(TAG, "uart_set_rx_timeout failed: %s", esp_err_to_name(err));
+      this->mark_failed();
+      return;
+    }
+  }
+  if (this->has_rx_pattern_) {
+    err = uart_enable_pattern_det_baud_intr(this->uart_num_, this->rx_pattern_, 1, 9, 0, 0);
+    if (err == ESP_OK)
+      err = uart_pattern_queue_reset(this->uart_num_, 20);
+    if (err != ESP_OK) {
+      ESP_LOGW(TAG, "Enabling RX pattern detection failed: %s", esp_err_to_name(err));
+      this->mark_failed();
+      return;
+    }
+  }
+  if (rx_events) {
+    // The event task wakes the loop to handle the end of a frame right away
+    App.enable_loop_wake();
+    if (xTaskCreate(IDFUARTComponent::rx_event_task, "uart_event", 2048, this, 5, nullptr) != pdPASS) {
+      ESP_LOGW(TAG, "Creating the RX event task failed");
+      this->mark_failed();
+      return;
+    }
+  }
+
   int8_t tx = this->tx_pin_ != nullptr ? this->tx_pin_->get_pin() : -1;
   int8_t rx = this->rx_pin_ != nullptr ? this->rx_pin_->get_pin() : -1;
 
@@ -112,6 +142,42 @@ void IDFUARTComponent::setup() {
   xSemaphoreGive(this->lock_);
 }
 
+void IDFUARTComponent::loop() {
+  if (this->rx_overflow_.exchange(false))
+    ESP_LOGW(TAG, "RX buffer overflow, received data was lost. Consider increasing rx_buffer_size.");
+  if (this->rx_frame_pending_.exchange(false))
+    this->rx_frame_callback_.call();
+}
+
+void IDFUARTComponent::rx_event_task(void *param) {
+  auto *uart = static_cast<IDFUARTComponent *>(param);
+  uart_event_t event;
+  while (true) {
+    if (xQueueReceive(uart->event_queue_, &event, portMAX_DELAY) != pdTRUE)
+      continue;
+    switch (event.type) {
+      case UART_DATA:
+        // Data events are also posted whenever the hardware FIFO fills up, only RX timeouts end a frame
+        if (uart->rx_idle_timeout_ == 0 || !event.timeout_flag)
+          continue;
+        break;
+      case UART_PATTERN_DET:
+        // The positions aren't used, drain them so the position queue doesn't fill up
+        while (uart_pattern_pop_pos(uart->uart_num_) != -1) {
+        }
+        break;
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        uart->rx_overflow_ = true;
+        break;
+      default:
+        continue;
+    }
+    uart->rx_frame_pending_ = true;
+    App.wake_loop_threadsafe();
+  }
+}
+
 void IDFUARTComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "UART Bus:");
   ESP_LOGCONFIG(TAG, "  Number: %u", this->uart_num_);
@@ -124,6 +190,10 @@ void IDFUARTComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Data Bits: %u", this->data_bits_);
   ESP_LOGCONFIG(TAG, "  Parity: %s", LOG_STR_ARG(parity_to_str(this->parity_)));
   ESP_LOGCONFIG(TAG, "  Stop bits: %u", this->stop_bits_);
+  if (this->rx_idle_timeout_ != 0)
+    ESP_LOGCONFIG(TAG, "  RX Idle Timeout: %u characters", this->rx_idle_timeout_);
+  if (this->has_rx_pattern_)
+    ESP_LOGCONFIG(TAG, "  RX Pattern: 0x%02X", this->rx_pattern_);
   this->check_logger_conflict();
 }
 
@@ -2,6 +2,7 @@
 
 #ifdef USE_ESP_IDF
 
+#include <atomic>
 #include <driver/uart.h>
 #include "esphome/core/component.h"
 #include "uart_component.h"
@@ -12,6 +13,7 @@ namespace uart {
 class IDFUARTComponent : public UARTComponent, public Component {
  public:
   void setup() override;
+  void loop() override;
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
@@ -23,7 +25,18 @@ class IDFUARTComponent : public UARTComponent, public Component {
   int available() override;
   void flush() override;
 
+  /// Report the end of a frame once the RX line was idle for this many characters, 0 to disable.
+  void set_rx_idle_timeout(uint8_t rx_idle_timeout) { this->rx_idle_timeout_ = rx_idle_timeout; }
+  /// Report the end of a frame (e.g. a line) whenever this byte is received.
+  void set_rx_pattern(uint8_t rx_pattern) {
+    this->rx_pattern_ = rx_pattern;
+    this->has_rx_pattern_ = true;
+  }
+
  protected:
+  /// FreeRTOS task waiting on the driver's event queue, it wakes up the main loop when a frame was received.
+  static void rx_event_task(void *param);
+
   void check_logger_conflict() override;
   uart_port_t uart_num_;
   uart_config_t get_config_();
@@ -31,6 +44,14 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   bool has_peek_{false};
   uint8_t peek_byte_;
+
+  QueueHandle_t event_queue_{nullptr};
+  uint8_t rx_idle_timeout_{0};
+  bool has_rx_pattern_{false};
+  uint8_t rx_pattern_;
+  /// Set by rx_event_task(), handled in loop().
+  std::atomic<bool> rx_frame_pending_{false};
+  std::atomic<bool> rx_overflow_{false};
 };
 
 }  // namespace uart
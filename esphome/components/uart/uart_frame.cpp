@@ -0,0 +1,107 @@
+#include "uart_frame.h"
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace uart {
+
+size_t UARTFrameExtractor::read_from(UARTDevice *device) {
+  int available = device->available();
+  if (available <= 0)
+    return 0;
+
+  this->compact_();
+  size_t at = this->buffer_.size();
+  this->buffer_.resize(at + std::min(size_t(available), this->max_frame_size_));
+  size_t len = device->read_available(&this->buffer_[at], this->buffer_.size() - at);
+  this->buffer_.resize(at + len);
+  return len;
+}
+
+void UARTFrameExtractor::feed(const uint8_t *data, size_t len) {
+  if (len == 0)
+    return;
+  this->compact_();
+  this->buffer_.insert(this->buffer_.end(), data, data + len);
+}
+
+bool UARTFrameExtractor::next_frame(const uint8_t **frame, size_t *len) {
+  while (this->size() != 0) {
+    size_t drop = 0;
+    size_t frame_len = this->find_frame_(this->peek(), this->size(), &drop);
+    if (frame_len != 0) {
+      *frame = this->peek();
+      *len = frame_len;
+      this->consumed_ += frame_len;
+      return true;
+    }
+    if (drop == 0) {
+      if (this->size() < this->max_frame_size_)
+        return false;
+      // Too long to ever become a valid frame
+      drop = this->size();
+    }
+    this->consumed_ += std::min(drop, this->size());
+  }
+  return false;
+}
+
+void UARTFrameExtractor::clear() {
+  this->buffer_.clear();
+  this->consumed_ = 0;
+}
+
+void UARTFrameExtractor::compact_() {
+  if (this->consumed_ == 0)
+    return;
+  this->buffer_.erase(this->buffer_.begin(), this->buffer_.begin() + this->consumed_);
+  this->consumed_ = 0;
+}
+
+size_t DelimiterFrameExtractor::find_frame_(const uint8_t *data, size_t len, size_t *drop) {
+  const auto *end = static_cast<const uint8_t *>(memchr(data, this->delimiter_, len));
+  if (end == nullptr)
+    return 0;
+  return end - data + 1;
+}
+
+size_t LengthFrameExtractor::find_frame_(const uint8_t *data, size_t len, size_t *drop) {
+  size_t header_len = std::min(len, this->header_.size());
+  if (memcmp(data, this->header_.data(), header_len) != 0) {
+    *drop = this->resync_(data, len);
+    return 0;
+  }
+
+  size_t length_end = this->length_offset_ + this->length_size_;
+  if (len < length_end)
+    return 0;
+  const uint8_t *field = data + this->length_offset_;
+  size_t length = field[0];
+  if (this->length_size_ == 2)
+    length = this->little_endian_ ? (field[1] << 8) | field[0] : (field[0] << 8) | field[1];
+
+  size_t frame_len = length + this->overhead_;
+  if (frame_len < length_end || frame_len > this->max_frame_size_) {
+    *drop = this->resync_(data, len);
+    return 0;
+  }
+  if (len < frame_len)
+    return 0;
+  if (this->checksum_ && !this->checksum_(data, frame_len)) {
+    *drop = this->resync_(data, len);
+    return 0;
+  }
+  return frame_len;
+}
+
+size_t LengthFrameExtractor::resync_(const uint8_t *data, size_t len) const {
+  if (this->header_.empty())
+    return 1;
+  const auto *start = static_cast<const uint8_t *>(memchr(data + 1, this->header_[0], len - 1));
+  if (start == nullptr)
+    return len;
+  return start - data;
+}
+
+}  // namespace uart
+}  // namespace esphome
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "uart.h"
+
+namespace esphome {
+namespace uart {
+
+/** Base class for splitting the bytes received from a UART into frames.
+ *
+ * Received bytes are appended to an internal buffer with read_from() or feed(), and complete frames are taken from
+ * the front of that buffer with next_frame(). Bytes that can't be the start of a valid frame are dropped, as is an
+ * incomplete frame that grows beyond the maximum frame size.
+ *
+ * Typical use from a component's loop():
+ *
+ * @code
+ * this->frames_.read_from(this);
+ * const uint8_t *frame;
+ * size_t len;
+ * while (this->frames_.next_frame(&frame, &len))
+ *   this->handle_frame_(frame, len);
+ * @endcode
+ */
+class UARTFrameExtractor {
+ public:
+  explicit UARTFrameExtractor(size_t max_frame_size) : max_frame_size_(max_frame_size) {}
+  virtual ~UARTFrameExtractor() = default;
+
+  /// Append all bytes the UART already received, up to the maximum frame size. Returns the number of bytes read.
+  size_t read_from(UARTDevice *device);
+  /// Append received bytes.
+  void feed(const uint8_t *data, size_t len);
+
+  /** Take the next complete frame from the buffer.
+   *
+   * The frame points into the internal buffer and stays valid until the next call to read_from(), feed() or clear().
+   *
+   * @param frame Set to the start of the frame.
+   * @param len Set to the length of the frame.
+   * @return Whether a complete frame was found, frame and len are only set if true.
+   */
+  bool next_frame(const uint8_t **frame, size_t *len);
+
+  /// The buffered bytes that aren't part of a complete frame yet.
+  const uint8_t *peek() const { return this->buffer_.data() + this->consumed_; }
+  /// The number of bytes returned by peek().
+  size_t size() const { return this->buffer_.size() - this->consumed_; }
+  /// Discard all buffered bytes.
+  void clear();
+
+ protected:
+  /** Check whether data starts with a complete frame.
+   *
+   * @param data The buffered bytes.
+   * @param len The number of buffered bytes, never 0.
+   * @param drop Set to the number of bytes at the front of data that can't be part of a valid frame.
+   * @return The length of the complete frame, or 0 if there is none (yet).
+   */
+  virtual size_t find_frame_(const uint8_t *data, size_t len, size_t *drop) = 0;
+
+  /// Remove the bytes of returned frames from the front of the buffer.
+  void compact_();
+
+  std::vector<uint8_t> buffer_;
+  size_t consumed_{0};
+  size_t max_frame_size_;
+};
+
+/// Frames end with a delimiter byte, for example '\n' for line based protocols. The delimiter is part of the frame.
+class DelimiterFrameExtractor : public UARTFrameExtractor {
+ public:
+  DelimiterFrameExtractor(uint8_t delimiter, size_t max_frame_size)
+      : UARTFrameExtractor(max_frame_size), delimiter_(delimiter) {}
+
+ protected:
+  size_t find_frame_(const uint8_t *data, size_t len, size_t *drop) override;
+
+  uint8_t delimiter_;
+};
+
+/** Frames start with a fixed header and contain a length field, optionally followed by a checksum.
+ *
+ * For example Tuya frames (55 AA, version, command, 16 bit big endian length, data, checksum) use a header of
+ * {0x55, 0xAA}, a length offset of 4, a length size of 2 and an overhead of 7.
+ */
+class LengthFrameExtractor : public UARTFrameExtractor {
+ public:
+  /**
+   * @param header The bytes every frame starts with.
+   * @param length_offset The offset of the length field from the start of the frame.
+   * @param length_size The size of the length field, 1 or 2 bytes.
+   * @param overhead The length of a frame in addition to the value of its length field.
+   * @param max_frame_size The maximum length of a frame.
+   */
+  LengthFrameExtractor(std::vector<uint8_t> header, size_t length_offset, uint8_t length_size, size_t overhead,
+                       size_t max_frame_size)
+      : UARTFrameExtractor(max_frame_size),
+        header_(std::move(header)),
+        length_offset_(length_offset),
+        length_size_(length_size),
+        overhead_(overhead) {}
+
+  /// Set whether multi-byte length fields are little endian, they are big endian by default.
+  void set_little_endian(bool little_endian) { this->little_endian_ = little_endian; }
+  /// Set a function that checks the checksum of a complete frame. Frames that fail the check are dropped.
+  void set_checksum(std::function<bool(const uint8_t *, size_t)> &&checksum) { this->checksum_ = std::move(checksum); }
+
+ protected:
+  size_t find_frame_(const uint8_t *data, size_t len, size_t *drop) override;
+  /// The number of bytes to drop to get to the next possible frame start.
+  size_t resync_(const uint8_t *data, size_t len) const;
+
+  std::vector<uint8_t> header_;
+  size_t length_offset_;
+  uint8_t length_size_;
+  size_t overhead_;
+  bool little_endian_{false};
+  std::function<bool(const uint8_t *, size_t)> checksum_;
+};
+
+}  // namespace uart
+}  // namespace esphome
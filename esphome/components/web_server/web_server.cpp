@@ -10,7 +10,9 @@
 
 #include "StreamString.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 
 #ifdef USE_LIGHT
 #include "esphome/components/light/light_json_schema.h"
@@ -28,6 +30,8 @@ namespace esphome {
 namespace web_server {
 
 static const char *const TAG = "web_server";
+static const uint8_t MAX_STATES_PER_LOOP = 8;
+static const size_t MAX_PACKETS_WAITING = 8;
 
 void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &klass, const std::string &action,
                const std::function<void(AsyncResponseStream &stream, EntityBase *obj)> &action_func = nullptr) {
@@ -50,29 +54,49 @@ void write_row(AsyncResponseStream *stream, EntityBase *obj, const std::string &
   stream->print("</tr>");
 }
 
-UrlMatch match_url(const std::string &url, bool only_domain = false) {
-  UrlMatch match;
+/// Compare two strings of known length, ordering them like std::string::compare().
+static int compare_str(const char *a, size_t a_len, const char *b, size_t b_len) {
+  int res = memcmp(a, b, std::min(a_len, b_len));
+  if (res != 0)
+    return res;
+  if (a_len == b_len)
+    return 0;
+  return a_len < b_len ? -1 : 1;
+}
+
+bool UrlMatch::domain_equals(const char *str) const {
+  return compare_str(this->domain, this->domain_len, str, strlen(str)) == 0;
+}
+bool UrlMatch::method_equals(const char *str) const {
+  return compare_str(this->method, this->method_len, str, strlen(str)) == 0;
+}
+
+UrlMatch match_url(const char *url, size_t url_len, bool only_domain = false) {
+  UrlMatch match{};
   match.valid = false;
-  size_t domain_end = url.find('/', 1);
-  if (domain_end == std::string::npos)
+  const char *url_end = url + url_len;
+  if (url_len < 1)
+    return match;
+  const char *domain_end = static_cast<const char *>(memchr(url + 1, '/', url_len - 1));
+  if (domain_end == nullptr)
     return match;
-  match.domain = url.substr(1, domain_end - 1);
+  match.domain = url + 1;
+  match.domain_len = domain_end - match.domain;
   if (only_domain) {
     match.valid = true;
     return match;
   }
-  if (url.length() == domain_end - 1)
-    return match;
-  size_t id_begin = domain_end + 1;
-  size_t id_end = url.find('/', id_begin);
+  match.id = domain_end + 1;
+  const char *id_end = static_cast<const char *>(memchr(match.id, '/', url_end - match.id));
   match.valid = true;
-  if (id_end == std::string::npos) {
-    match.id = url.substr(id_begin, url.length() - id_begin);
+  if (id_end == nullptr) {
+    match.id_len = url_end - match.id;
+    match.method = url_end;
     return match;
   }
-  match.id = url.substr(id_begin, id_end - id_begin);
-  size_t method_begin = id_end + 1;
-  match.method = url.substr(method_begin, url.length() - method_begin);
+  match.id_len = id_end - match.id;
+  match.method = id_end + 1;
+  match.method_len = url_end - match.method;
   return match;
 }
 
@@ -89,91 +113,94 @@ void WebServer::setup() {
   this->events_.onConnect([this](AsyncEventSourceClient *client) {
     // Configure reconnect timeout
     client->send("", "ping", millis(), 30000);
-
-#ifdef USE_SENSOR
-    for (auto *obj : App.get_sensors()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->sensor_json(obj, obj->state).c_str(), "state");
+    // The states are streamed from loop(), sending them all from here would overflow the client's message queue.
+    // A running snapshot isn't restarted, the other clients would get the states it already sent again.
+    if (this->entities_iterator_.is_running()) {
+      this->snapshot_requested_ = true;
+    } else {
+      this->entities_iterator_.begin(this->include_internal_);
     }
+  });
+
+#ifdef USE_LOGGER
+  if (logger::global_logger != nullptr) {
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+  }
 #endif
+  this->base_->add_handler(&this->events_);
+  this->base_->add_handler(this);
+
+  if (this->allow_ota_)
+    this->base_->add_ota_handler();
 
+  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+}
+EntityBase *WebServer::find_entity_(const UrlMatch &match) const {
+  optional<EntityType> type;
+#ifdef USE_SENSOR
+  if (match.domain_equals("sensor"))
+    type = ENTITY_TYPE_SENSOR;
+#endif
 #ifdef USE_SWITCH
-    for (auto *obj : App.get_switches()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->switch_json(obj, obj->state).c_str(), "state");
-    }
+  if (match.domain_equals("switch"))
+    type = ENTITY_TYPE_SWITCH;
+#endif
+#ifdef USE_BUTTON
+  if (match.domain_equals("button"))
+    type = ENTITY_TYPE_BUTTON;
 #endif
-
 #ifdef USE_BINARY_SENSOR
-    for (auto *obj : App.get_binary_sensors()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->binary_sensor_json(obj, obj->state).c_str(), "state");
-    }
+  if (match.domain_equals("binary_sensor"))
+    type = ENTITY_TYPE_BINARY_SENSOR;
 #endif
-
 #ifdef USE_FAN
-    for (auto *obj : App.get_fans()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->fan_json(obj).c_str(), "state");
-    }
+  if (match.domain_equals("fan"))
+    type = ENTITY_TYPE_FAN;
 #endif
-
 #ifdef USE_LIGHT
-    for (auto *obj : App.get_lights()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->light_json(obj).c_str(), "state");
-    }
+  if (match.domain_equals("light"))
+    type = ENTITY_TYPE_LIGHT;
 #endif
-
 #ifdef USE_TEXT_SENSOR
-    for (auto *obj : App.get_text_sensors()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->text_sensor_json(obj, obj->state).c_str(), "state");
-    }
+  if (match.domain_equals("text_sensor"))
+    type = ENTITY_TYPE_TEXT_SENSOR;
 #endif
-
 #ifdef USE_COVER
-    for (auto *obj : App.get_covers()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->cover_json(obj).c_str(), "state");
-    }
+  if (match.domain_equals("cover"))
+    type = ENTITY_TYPE_COVER;
 #endif
-
 #ifdef USE_NUMBER
-    for (auto *obj : App.get_numbers()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->number_json(obj, obj->state).c_str(), "state");
-    }
+  if (match.domain_equals("number"))
+    type = ENTITY_TYPE_NUMBER;
 #endif
-
 #ifdef USE_SELECT
-    for (auto *obj : App.get_selects()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->select_json(obj, obj->state).c_str(), "state");
-    }
+  if (match.domain_equals("select"))
+    type = ENTITY_TYPE_SELECT;
 #endif
-
 #ifdef USE_LOCK
-    for (auto *obj : App.get_locks()) {
-      if (this->include_internal_ || !obj->is_internal())
-        client->send(this->lock_json(obj, obj->state).c_str(), "state");
-    }
+  if (match.domain_equals("lock"))
+    type = ENTITY_TYPE_LOCK;
 #endif
-  });
-
-#ifdef USE_LOGGER
-  if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback(
-        [this](int level, const char *tag, const char *message) { this->events_.send(message, "log", millis()); });
+  if (!type.has_value())
+    return nullptr;
+  return App.get_entity_registry().find(*type, match.id, match.id_len, true);
+}
+void WebServer::loop() {
+  if (this->snapshot_requested_ && !this->entities_iterator_.is_running()) {
+    this->snapshot_requested_ = false;
+    this->entities_iterator_.begin(this->include_internal_);
   }
-#endif
-  this->base_->add_handler(&this->events_);
-  this->base_->add_handler(this);
-
-  if (this->allow_ota_)
-    this->base_->add_ota_handler();
-
-  this->set_interval(10000, [this]() { this->events_.send("", "ping", millis(), 30000); });
+  for (uint8_t i = 0; i < MAX_STATES_PER_LOOP && this->entities_iterator_.is_running(); i++) {
+    // Wait for the clients to drain their queues, the event source drops messages once it is full
+    if (this->events_.avgPacketsWaiting() >= MAX_PACKETS_WAITING)
+      break;
+    this->entities_iterator_.advance();
+  }
+}
+bool WebServer::should_send_update_() const {
+  // Live updates are sent even while a snapshot is running, clients that already got theirs rely on them
+  return this->events_.count() != 0;
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
@@ -356,17 +383,19 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->sensor_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = static_cast<sensor::Sensor *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  std::string data = this->sensor_json(obj, obj->state);
+  request->send(200, "text/json", data.c_str());
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
   return json::build_json([obj, value](JsonObject root) {
@@ -382,17 +411,19 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value) {
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->text_sensor_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->text_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = static_cast<text_sensor::TextSensor *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  std::string data = this->text_sensor_json(obj, obj->state);
+  request->send(200, "text/json", data.c_str());
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value) {
   return json::build_json([obj, value](JsonObject root) {
@@ -405,6 +436,8 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->switch_json(obj, state).c_str(), "state");
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
@@ -415,51 +448,51 @@ std::string WebServer::switch_json(switch_::Switch *obj, bool value) {
   });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->switch_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      this->defer([obj]() { obj->turn_on(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = static_cast<switch_::Switch *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    std::string data = this->switch_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("toggle")) {
+    this->defer([obj]() { obj->toggle(); });
+    request->send(200);
+  } else if (match.method_equals("turn_on")) {
+    this->defer([obj]() { obj->turn_on(); });
+    request->send(200);
+  } else if (match.method_equals("turn_off")) {
+    this->defer([obj]() { obj->turn_off(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BUTTON
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_POST && match.method == "press") {
-      this->defer([obj]() { obj->press(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = static_cast<button::Button *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_POST && match.method_equals("press")) {
+    this->defer([obj]() { obj->press(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->binary_sensor_json(obj, state).c_str(), "state");
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value) {
@@ -470,19 +503,23 @@ std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool
   });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-    std::string data = this->binary_sensor_json(obj, obj->state);
-    request->send(200, "text/json", data.c_str());
+  auto *obj = static_cast<binary_sensor::BinarySensor *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  std::string data = this->binary_sensor_json(obj, obj->state);
+  request->send(200, "text/json", data.c_str());
 }
 #endif
 
 #ifdef USE_FAN
-void WebServer::on_fan_update(fan::Fan *obj) { this->events_.send(this->fan_json(obj).c_str(), "state"); }
+void WebServer::on_fan_update(fan::Fan *obj) {
+  if (!this->should_send_update_())
+    return;
+  this->events_.send(this->fan_json(obj).c_str(), "state");
+}
 std::string WebServer::fan_json(fan::Fan *obj) {
   return json::build_json([obj](JsonObject root) {
     root["id"] = "fan-" + obj->get_object_id();
@@ -512,125 +549,127 @@ std::string WebServer::fan_json(fan::Fan *obj) {
   });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->fan_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("speed")) {
-        String speed = request->getParam("speed")->value();
+  auto *obj = static_cast<fan::Fan *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
+
+  if (request->method() == HTTP_GET) {
+    std::string data = this->fan_json(obj);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("toggle")) {
+    this->defer([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_on")) {
+    auto call = obj->turn_on();
+    if (request->hasParam("speed")) {
+      String speed = request->getParam("speed")->value();
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-        call.set_speed(speed.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
+      call.set_speed(speed.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
 #pragma GCC diagnostic pop
+    }
+    if (request->hasParam("speed_level")) {
+      String speed_level = request->getParam("speed_level")->value();
+      auto val = parse_number<int>(speed_level.c_str());
+      if (!val.has_value()) {
+        ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+        return;
       }
-      if (request->hasParam("speed_level")) {
-        String speed_level = request->getParam("speed_level")->value();
-        auto val = parse_number<int>(speed_level.c_str());
-        if (!val.has_value()) {
-          ESP_LOGW(TAG, "Can't convert '%s' to number!", speed_level.c_str());
+      call.set_speed(*val);
+    }
+    if (request->hasParam("oscillation")) {
+      String speed = request->getParam("oscillation")->value();
+      auto val = parse_on_off(speed.c_str());
+      switch (val) {
+        case PARSE_ON:
+          call.set_oscillating(true);
+          break;
+        case PARSE_OFF:
+          call.set_oscillating(false);
+          break;
+        case PARSE_TOGGLE:
+          call.set_oscillating(!obj->oscillating);
+          break;
+        case PARSE_NONE:
+          request->send(404);
           return;
-        }
-        call.set_speed(*val);
-      }
-      if (request->hasParam("oscillation")) {
-        String speed = request->getParam("oscillation")->value();
-        auto val = parse_on_off(speed.c_str());
-        switch (val) {
-          case PARSE_ON:
-            call.set_oscillating(true);
-            break;
-          case PARSE_OFF:
-            call.set_oscillating(false);
-            break;
-          case PARSE_TOGGLE:
-            call.set_oscillating(!obj->oscillating);
-            break;
-          case PARSE_NONE:
-            request->send(404);
-            return;
-        }
       }
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      this->defer([obj]() { obj->turn_off().perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
     }
-    return;
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_off")) {
+    this->defer([obj]() { obj->turn_off().perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 #endif
 
 #ifdef USE_LIGHT
-void WebServer::on_light_update(light::LightState *obj) { this->events_.send(this->light_json(obj).c_str(), "state"); }
+void WebServer::on_light_update(light::LightState *obj) {
+  if (!this->should_send_update_())
+    return;
+  this->events_.send(this->light_json(obj).c_str(), "state");
+}
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->light_json(obj);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "toggle") {
-      this->defer([obj]() { obj->toggle().perform(); });
-      request->send(200);
-    } else if (match.method == "turn_on") {
-      auto call = obj->turn_on();
-      if (request->hasParam("brightness"))
-        call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
-      if (request->hasParam("r"))
-        call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
-      if (request->hasParam("g"))
-        call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
-      if (request->hasParam("b"))
-        call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
-      if (request->hasParam("white_value"))
-        call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
-      if (request->hasParam("color_temp"))
-        call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
-
-      if (request->hasParam("flash")) {
-        float length_s = request->getParam("flash")->value().toFloat();
-        call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
-      }
+  auto *obj = static_cast<light::LightState *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-      if (request->hasParam("transition")) {
-        float length_s = request->getParam("transition")->value().toFloat();
-        call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
-      }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->light_json(obj);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("toggle")) {
+    this->defer([obj]() { obj->toggle().perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_on")) {
+    auto call = obj->turn_on();
+    if (request->hasParam("brightness"))
+      call.set_brightness(request->getParam("brightness")->value().toFloat() / 255.0f);
+    if (request->hasParam("r"))
+      call.set_red(request->getParam("r")->value().toFloat() / 255.0f);
+    if (request->hasParam("g"))
+      call.set_green(request->getParam("g")->value().toFloat() / 255.0f);
+    if (request->hasParam("b"))
+      call.set_blue(request->getParam("b")->value().toFloat() / 255.0f);
+    if (request->hasParam("white_value"))
+      call.set_white(request->getParam("white_value")->value().toFloat() / 255.0f);
+    if (request->hasParam("color_temp"))
+      call.set_color_temperature(request->getParam("color_temp")->value().toFloat());
+
+    if (request->hasParam("flash")) {
+      float length_s = request->getParam("flash")->value().toFloat();
+      call.set_flash_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      if (request->hasParam("effect")) {
-        const char *effect = request->getParam("effect")->value().c_str();
-        call.set_effect(effect);
-      }
+    if (request->hasParam("transition")) {
+      float length_s = request->getParam("transition")->value().toFloat();
+      call.set_transition_length(static_cast<uint32_t>(length_s * 1000));
+    }
 
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else if (match.method == "turn_off") {
-      auto call = obj->turn_off();
-      if (request->hasParam("transition")) {
-        auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
-        call.set_transition_length(length);
-      }
-      this->defer([call]() mutable { call.perform(); });
-      request->send(200);
-    } else {
-      request->send(404);
+    if (request->hasParam("effect")) {
+      const char *effect = request->getParam("effect")->value().c_str();
+      call.set_effect(effect);
     }
-    return;
+
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else if (match.method_equals("turn_off")) {
+    auto call = obj->turn_off();
+    if (request->hasParam("transition")) {
+      auto length = (uint32_t) request->getParam("transition")->value().toFloat() * 1000;
+      call.set_transition_length(length);
+    }
+    this->defer([call]() mutable { call.perform(); });
+    request->send(200);
+  } else {
+    request->send(404);
   }
-  request->send(404);
 }
 std::string WebServer::light_json(light::LightState *obj) {
   return json::build_json([obj](JsonObject root) {
@@ -642,47 +681,50 @@ std::string WebServer::light_json(light::LightState *obj) {
 #endif
 
 #ifdef USE_COVER
-void WebServer::on_cover_update(cover::Cover *obj) { this->events_.send(this->cover_json(obj).c_str(), "state"); }
+void WebServer::on_cover_update(cover::Cover *obj) {
+  if (!this->should_send_update_())
+    return;
+  this->events_.send(this->cover_json(obj).c_str(), "state");
+}
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->cover_json(obj);
-      request->send(200, "text/json", data.c_str());
-      continue;
-    }
-
-    auto call = obj->make_call();
-    if (match.method == "open") {
-      call.set_command_open();
-    } else if (match.method == "close") {
-      call.set_command_close();
-    } else if (match.method == "stop") {
-      call.set_command_stop();
-    } else if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  auto *obj = static_cast<cover::Cover *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    auto traits = obj->get_traits();
-    if ((request->hasParam("position") && !traits.get_supports_position()) ||
-        (request->hasParam("tilt") && !traits.get_supports_tilt())) {
-      request->send(409);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->cover_json(obj);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    if (request->hasParam("position"))
-      call.set_position(request->getParam("position")->value().toFloat());
-    if (request->hasParam("tilt"))
-      call.set_tilt(request->getParam("tilt")->value().toFloat());
+  auto call = obj->make_call();
+  if (match.method_equals("open")) {
+    call.set_command_open();
+  } else if (match.method_equals("close")) {
+    call.set_command_close();
+  } else if (match.method_equals("stop")) {
+    call.set_command_stop();
+  } else if (!match.method_equals("set")) {
+    request->send(404);
+    return;
+  }
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
+  auto traits = obj->get_traits();
+  if ((request->hasParam("position") && !traits.get_supports_position()) ||
+      (request->hasParam("tilt") && !traits.get_supports_tilt())) {
+    request->send(409);
     return;
   }
-  request->send(404);
+
+  if (request->hasParam("position"))
+    call.set_position(request->getParam("position")->value().toFloat());
+  if (request->hasParam("tilt"))
+    call.set_tilt(request->getParam("tilt")->value().toFloat());
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::cover_json(cover::Cover *obj) {
   return json::build_json([obj](JsonObject root) {
@@ -699,38 +741,39 @@ std::string WebServer::cover_json(cover::Cover *obj) {
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->number_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->number_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
+  auto *obj = static_cast<number::Number *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->number_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (!match.method_equals("set")) {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("value")) {
-      String value = request->getParam("value")->value();
-      optional<float> value_f = parse_number<float>(value.c_str());
-      if (value_f.has_value())
-        call.set_value(*value_f);
-    }
+  auto call = obj->make_call();
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("value")) {
+    String value = request->getParam("value")->value();
+    optional<float> value_f = parse_number<float>(value.c_str());
+    if (value_f.has_value())
+      call.set_value(*value_f);
   }
-  request->send(404);
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::number_json(number::Number *obj, float value) {
   return json::build_json([obj, value](JsonObject root) {
@@ -744,36 +787,37 @@ std::string WebServer::number_json(number::Number *obj, float value) {
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->select_json(obj, state).c_str(), "state");
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->select_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-      return;
-    }
+  auto *obj = static_cast<select::Select *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
+    return;
+  }
 
-    if (match.method != "set") {
-      request->send(404);
-      return;
-    }
+  if (request->method() == HTTP_GET) {
+    std::string data = this->select_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+    return;
+  }
 
-    auto call = obj->make_call();
+  if (!match.method_equals("set")) {
+    request->send(404);
+    return;
+  }
 
-    if (request->hasParam("option")) {
-      String option = request->getParam("option")->value();
-      call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
-    }
+  auto call = obj->make_call();
 
-    this->defer([call]() mutable { call.perform(); });
-    request->send(200);
-    return;
+  if (request->hasParam("option")) {
+    String option = request->getParam("option")->value();
+    call.set_option(option.c_str());  // NOLINT(clang-diagnostic-deprecated-declarations)
   }
-  request->send(404);
+
+  this->defer([call]() mutable { call.perform(); });
+  request->send(200);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value) {
   return json::build_json([obj, value](JsonObject root) {
@@ -786,6 +830,8 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
+  if (!this->should_send_update_())
+    return;
   this->events_.send(this->lock_json(obj, obj->state).c_str(), "state");
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value) {
@@ -796,28 +842,27 @@ std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value) {
   });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
-  for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
-      continue;
-
-    if (request->method() == HTTP_GET) {
-      std::string data = this->lock_json(obj, obj->state);
-      request->send(200, "text/json", data.c_str());
-    } else if (match.method == "lock") {
-      this->defer([obj]() { obj->lock(); });
-      request->send(200);
-    } else if (match.method == "unlock") {
-      this->defer([obj]() { obj->unlock(); });
-      request->send(200);
-    } else if (match.method == "open") {
-      this->defer([obj]() { obj->open(); });
-      request->send(200);
-    } else {
-      request->send(404);
-    }
+  auto *obj = static_cast<lock::Lock *>(match.entity);
+  if (obj == nullptr) {
+    request->send(404);
     return;
   }
-  request->send(404);
+
+  if (request->method() == HTTP_GET) {
+    std::string data = this->lock_json(obj, obj->state);
+    request->send(200, "text/json", data.c_str());
+  } else if (match.method_equals("lock")) {
+    this->defer([obj]() { obj->lock(); });
+    request->send(200);
+  } else if (match.method_equals("unlock")) {
+    this->defer([obj]() { obj->unlock(); });
+    request->send(200);
+  } else if (match.method_equals("open")) {
+    this->defer([obj]() { obj->open(); });
+    request->send(200);
+  } else {
+    request->send(404);
+  }
 }
 #endif
 
@@ -835,61 +880,61 @@ bool WebServer::canHandle(AsyncWebServerRequest *request) {
     return true;
 #endif
 
-  UrlMatch match = match_url(request->url().c_str(), true);
+  UrlMatch match = match_url(request->url().c_str(), request->url().length(), true);
   if (!match.valid)
     return false;
 #ifdef USE_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "sensor")
+  if (request->method() == HTTP_GET && match.domain_equals("sensor"))
     return true;
 #endif
 
 #ifdef USE_SWITCH
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "switch")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("switch"))
     return true;
 #endif
 
 #ifdef USE_BUTTON
-  if (request->method() == HTTP_POST && match.domain == "button")
+  if (request->method() == HTTP_POST && match.domain_equals("button"))
     return true;
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "binary_sensor")
+  if (request->method() == HTTP_GET && match.domain_equals("binary_sensor"))
     return true;
 #endif
 
 #ifdef USE_FAN
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "fan")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("fan"))
     return true;
 #endif
 
 #ifdef USE_LIGHT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "light")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("light"))
     return true;
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  if (request->method() == HTTP_GET && match.domain == "text_sensor")
+  if (request->method() == HTTP_GET && match.domain_equals("text_sensor"))
     return true;
 #endif
 
 #ifdef USE_COVER
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "cover")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("cover"))
     return true;
 #endif
 
 #ifdef USE_NUMBER
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "number")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("number"))
     return true;
 #endif
 
 #ifdef USE_SELECT
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "select")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("select"))
     return true;
 #endif
 
 #ifdef USE_LOCK
-  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain == "lock")
+  if ((request->method() == HTTP_POST || request->method() == HTTP_GET) && match.domain_equals("lock"))
     return true;
 #endif
 
@@ -915,79 +960,84 @@ void WebServer::handleRequest(AsyncWebServerRequest *request) {
   }
 #endif
 
-  UrlMatch match = match_url(request->url().c_str());
+  UrlMatch match = match_url(request->url().c_str(), request->url().length());
+  if (!match.valid) {
+    request->send(404);
+    return;
+  }
+  match.entity = this->find_entity_(match);
 #ifdef USE_SENSOR
-  if (match.domain == "sensor") {
+  if (match.domain_equals("sensor")) {
     this->handle_sensor_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_SWITCH
-  if (match.domain == "switch") {
+  if (match.domain_equals("switch")) {
     this->handle_switch_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_BUTTON
-  if (match.domain == "button") {
+  if (match.domain_equals("button")) {
     this->handle_button_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_BINARY_SENSOR
-  if (match.domain == "binary_sensor") {
+  if (match.domain_equals("binary_sensor")) {
     this->handle_binary_sensor_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_FAN
-  if (match.domain == "fan") {
+  if (match.domain_equals("fan")) {
     this->handle_fan_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_LIGHT
-  if (match.domain == "light") {
+  if (match.domain_equals("light")) {
     this->handle_light_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  if (match.domain == "text_sensor") {
+  if (match.domain_equals("text_sensor")) {
     this->handle_text_sensor_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_COVER
-  if (match.domain == "cover") {
+  if (match.domain_equals("cover")) {
     this->handle_cover_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_NUMBER
-  if (match.domain == "number") {
+  if (match.domain_equals("number")) {
     this->handle_number_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_SELECT
-  if (match.domain == "select") {
+  if (match.domain_equals("select")) {
     this->handle_select_request(request, match);
     return;
   }
 #endif
 
 #ifdef USE_LOCK
-  if (match.domain == "lock") {
+  if (match.domain_equals("lock")) {
     this->handle_lock_request(request, match);
     return;
   }
@@ -4,19 +4,28 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
+#include "esphome/core/entity_base.h"
 #include "esphome/components/web_server_base/web_server_base.h"
+#include "list_entities.h"
 
 #include <vector>
 
 namespace esphome {
 namespace web_server {
 
-/// Internal helper struct that is used to parse incoming URLs
+/// Internal helper struct that is used to parse incoming URLs, it points into the request's URL without copying it.
 struct UrlMatch {
-  std::string domain;  ///< The domain of the component, for example "sensor"
-  std::string id;      ///< The id of the device that's being accessed, for example "living_room_fan"
-  std::string method;  ///< The method that's being called, for example "turn_on"
+  const char *domain;  ///< The domain of the component, for example "sensor"
+  size_t domain_len;   ///< Length of the domain
+  const char *id;      ///< The id of the device that's being accessed, for example "living_room_fan"
+  size_t id_len;       ///< Length of the id
+  const char *method;  ///< The method that's being called, for example "turn_on"
+  size_t method_len;   ///< Length of the method
+  EntityBase *entity;  ///< The entity addressed by domain and id, nullptr if there is none
   bool valid;          ///< Whether this match is valid
+
+  bool domain_equals(const char *str) const;
+  bool method_equals(const char *str) const;
 };
 
 /** This class allows users to create a web server with their ESP nodes.
@@ -30,7 +39,7 @@ struct UrlMatch {
  */
 class WebServer : public Controller, public Component, public AsyncWebHandler {
  public:
-  WebServer(web_server_base::WebServerBase *base) : base_(base) {}
+  WebServer(web_server_base::WebServerBase *base) : base_(base), entities_iterator_(this) {}
 
   /** Set the URL to the CSS <link> that's sent to each client. Defaults to
    * https://esphome.io/_static/webserver-v1.min.css
@@ -74,6 +83,8 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   // (In most use cases you won't need these)
   /// Setup the internal web server and register handlers.
   void setup() override;
+  /// Stream the pending state snapshot to the event source clients.
+  void loop() override;
 
   void dump_config() override;
 
@@ -203,8 +214,19 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool isRequestHandlerTrivial() override;
 
  protected:
+  friend ListEntitiesIterator;
+
+  /// Look up the entity the given domain and id refer to, nullptr if it doesn't exist.
+  EntityBase *find_entity_(const UrlMatch &match) const;
+
+  /// Whether a live state update needs to be sent, which is the case when any client is connected.
+  bool should_send_update_() const;
+
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
+  ListEntitiesIterator entities_iterator_;
+  /// A client connected while a snapshot was running, start another one once it's done.
+  bool snapshot_requested_{false};
   const char *css_url_{nullptr};
   const char *css_include_{nullptr};
   const char *js_url_{nullptr};
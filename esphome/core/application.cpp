@@ -3,6 +3,11 @@
 #include "esphome/core/version.h"
 #include "esphome/core/hal.h"
 
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
 #ifdef USE_STATUS_LED
 #include "esphome/components/status_led/status_led.h"
 #endif
@@ -27,6 +32,9 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+  // All entities are registered by now
+  this->entities_.build();
+
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -93,7 +101,20 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
+#ifdef USE_ESP32
+    const TickType_t delay_ticks = delay_time / portTICK_PERIOD_MS;
+    if (this->loop_task_handle_ == nullptr) {
+      delay(delay_time);
+    } else if (delay_ticks == 0) {
+      // Waiting for 0 ticks would return right away without letting other tasks run
+      yield();
+    } else {
+      // Sleep like delay(), but wake_loop_threadsafe() can end it early
+      ulTaskNotifyTake(pdTRUE, delay_ticks);
+    }
+#else
     delay(delay_time);
+#endif
   }
   this->last_loop_ = now;
 
@@ -110,6 +131,19 @@ void Application::loop() {
   }
 }
 
+void Application::enable_loop_wake() {
+#ifdef USE_ESP32
+  this->loop_task_handle_ = xTaskGetCurrentTaskHandle();
+#endif
+}
+
+void Application::wake_loop_threadsafe() {
+#ifdef USE_ESP32
+  if (this->loop_task_handle_ != nullptr)
+    xTaskNotifyGive(static_cast<TaskHandle_t>(this->loop_task_handle_));
+#endif
+}
+
 void IRAM_ATTR HOT Application::feed_wdt() {
   static uint32_t last_feed = 0;
   uint32_t now = micros();
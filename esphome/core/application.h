@@ -5,6 +5,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/preferences.h"
 #include "esphome/core/component.h"
+#include "esphome/core/entity_registry.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/scheduler.h"
@@ -64,51 +65,85 @@ class Application {
 #ifdef USE_BINARY_SENSOR
   void register_binary_sensor(binary_sensor::BinarySensor *binary_sensor) {
     this->binary_sensors_.push_back(binary_sensor);
+    this->entities_.add(ENTITY_TYPE_BINARY_SENSOR, binary_sensor);
   }
 #endif
 
 #ifdef USE_SENSOR
-  void register_sensor(sensor::Sensor *sensor) { this->sensors_.push_back(sensor); }
+  void register_sensor(sensor::Sensor *sensor) {
+    this->sensors_.push_back(sensor);
+    this->entities_.add(ENTITY_TYPE_SENSOR, sensor);
+  }
 #endif
 
 #ifdef USE_SWITCH
-  void register_switch(switch_::Switch *a_switch) { this->switches_.push_back(a_switch); }
+  void register_switch(switch_::Switch *a_switch) {
+    this->switches_.push_back(a_switch);
+    this->entities_.add(ENTITY_TYPE_SWITCH, a_switch);
+  }
 #endif
 
 #ifdef USE_BUTTON
-  void register_button(button::Button *button) { this->buttons_.push_back(button); }
+  void register_button(button::Button *button) {
+    this->buttons_.push_back(button);
+    this->entities_.add(ENTITY_TYPE_BUTTON, button);
+  }
 #endif
 
 #ifdef USE_TEXT_SENSOR
-  void register_text_sensor(text_sensor::TextSensor *sensor) { this->text_sensors_.push_back(sensor); }
+  void register_text_sensor(text_sensor::TextSensor *sensor) {
+    this->text_sensors_.push_back(sensor);
+    this->entities_.add(ENTITY_TYPE_TEXT_SENSOR, sensor);
+  }
 #endif
 
 #ifdef USE_FAN
-  void register_fan(fan::Fan *state) { this->fans_.push_back(state); }
+  void register_fan(fan::Fan *state) {
+    this->fans_.push_back(state);
+    this->entities_.add(ENTITY_TYPE_FAN, state);
+  }
 #endif
 
 #ifdef USE_COVER
-  void register_cover(cover::Cover *cover) { this->covers_.push_back(cover); }
+  void register_cover(cover::Cover *cover) {
+    this->covers_.push_back(cover);
+    this->entities_.add(ENTITY_TYPE_COVER, cover);
+  }
 #endif
 
 #ifdef USE_CLIMATE
-  void register_climate(climate::Climate *climate) { this->climates_.push_back(climate); }
+  void register_climate(climate::Climate *climate) {
+    this->climates_.push_back(climate);
+    this->entities_.add(ENTITY_TYPE_CLIMATE, climate);
+  }
 #endif
 
 #ifdef USE_LIGHT
-  void register_light(light::LightState *light) { this->lights_.push_back(light); }
+  void register_light(light::LightState *light) {
+    this->lights_.push_back(light);
+    this->entities_.add(ENTITY_TYPE_LIGHT, light);
+  }
 #endif
 
 #ifdef USE_NUMBER
-  void register_number(number::Number *number) { this->numbers_.push_back(number); }
+  void register_number(number::Number *number) {
+    this->numbers_.push_back(number);
+    this->entities_.add(ENTITY_TYPE_NUMBER, number);
+  }
 #endif
 
 #ifdef USE_SELECT
-  void register_select(select::Select *select) { this->selects_.push_back(select); }
+  void register_select(select::Select *select) {
+    this->selects_.push_back(select);
+    this->entities_.add(ENTITY_TYPE_SELECT, select);
+  }
 #endif
 
 #ifdef USE_LOCK
-  void register_lock(lock::Lock *a_lock) { this->locks_.push_back(a_lock); }
+  void register_lock(lock::Lock *a_lock) {
+    this->locks_.push_back(a_lock);
+    this->entities_.add(ENTITY_TYPE_LOCK, a_lock);
+  }
 #endif
 
   /// Register the component in this Application instance.
@@ -146,6 +181,22 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Let wake_loop_threadsafe() end the sleep between loop iterations early.
+   *
+   * Must be called from setup() or loop() of a component that calls wake_loop_threadsafe(). The loop then sleeps on a
+   * task notification of the loop task instead of with delay(), so it is only done when a component needs it. Only
+   * has an effect on the ESP32.
+   */
+  void enable_loop_wake();
+
+  /** Run the next loop() right away instead of sleeping for the rest of the loop interval.
+   *
+   * This lets drivers that receive data in another task (for example from a UART event queue) have it handled
+   * without waiting for the next loop. Can be called from any task, but not from interrupts. Only has an effect
+   * after enable_loop_wake() was called.
+   */
+  void wake_loop_threadsafe();
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -165,112 +216,80 @@ class Application {
 
   uint32_t get_app_state() const { return this->app_state_; }
 
+  /// Index of all entities by key and object id.
+  const EntityRegistry &get_entity_registry() const { return this->entities_; }
+
 #ifdef USE_BINARY_SENSOR
   const std::vector<binary_sensor::BinarySensor *> &get_binary_sensors() { return this->binary_sensors_; }
   binary_sensor::BinarySensor *get_binary_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->binary_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<binary_sensor::BinarySensor *>(
+        this->entities_.find(ENTITY_TYPE_BINARY_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_SWITCH
   const std::vector<switch_::Switch *> &get_switches() { return this->switches_; }
   switch_::Switch *get_switch_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->switches_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<switch_::Switch *>(this->entities_.find(ENTITY_TYPE_SWITCH, key, include_internal));
   }
 #endif
 #ifdef USE_BUTTON
   const std::vector<button::Button *> &get_buttons() { return this->buttons_; }
   button::Button *get_button_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->buttons_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<button::Button *>(this->entities_.find(ENTITY_TYPE_BUTTON, key, include_internal));
   }
 #endif
 #ifdef USE_SENSOR
   const std::vector<sensor::Sensor *> &get_sensors() { return this->sensors_; }
   sensor::Sensor *get_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<sensor::Sensor *>(this->entities_.find(ENTITY_TYPE_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_TEXT_SENSOR
   const std::vector<text_sensor::TextSensor *> &get_text_sensors() { return this->text_sensors_; }
   text_sensor::TextSensor *get_text_sensor_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->text_sensors_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<text_sensor::TextSensor *>(this->entities_.find(ENTITY_TYPE_TEXT_SENSOR, key, include_internal));
   }
 #endif
 #ifdef USE_FAN
   const std::vector<fan::Fan *> &get_fans() { return this->fans_; }
   fan::Fan *get_fan_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->fans_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<fan::Fan *>(this->entities_.find(ENTITY_TYPE_FAN, key, include_internal));
   }
 #endif
 #ifdef USE_COVER
   const std::vector<cover::Cover *> &get_covers() { return this->covers_; }
   cover::Cover *get_cover_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->covers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<cover::Cover *>(this->entities_.find(ENTITY_TYPE_COVER, key, include_internal));
   }
 #endif
 #ifdef USE_LIGHT
   const std::vector<light::LightState *> &get_lights() { return this->lights_; }
   light::LightState *get_light_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->lights_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<light::LightState *>(this->entities_.find(ENTITY_TYPE_LIGHT, key, include_internal));
   }
 #endif
 #ifdef USE_CLIMATE
   const std::vector<climate::Climate *> &get_climates() { return this->climates_; }
   climate::Climate *get_climate_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->climates_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<climate::Climate *>(this->entities_.find(ENTITY_TYPE_CLIMATE, key, include_internal));
   }
 #endif
 #ifdef USE_NUMBER
   const std::vector<number::Number *> &get_numbers() { return this->numbers_; }
   number::Number *get_number_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->numbers_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<number::Number *>(this->entities_.find(ENTITY_TYPE_NUMBER, key, include_internal));
   }
 #endif
 #ifdef USE_SELECT
   const std::vector<select::Select *> &get_selects() { return this->selects_; }
   select::Select *get_select_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->selects_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<select::Select *>(this->entities_.find(ENTITY_TYPE_SELECT, key, include_internal));
   }
 #endif
 #ifdef USE_LOCK
   const std::vector<lock::Lock *> &get_locks() { return this->locks_; }
   lock::Lock *get_lock_by_key(uint32_t key, bool include_internal = false) {
-    for (auto *obj : this->locks_)
-      if (obj->get_object_id_hash() == key && (include_internal || !obj->is_internal()))
-        return obj;
-    return nullptr;
+    return static_cast<lock::Lock *>(this->entities_.find(ENTITY_TYPE_LOCK, key, include_internal));
   }
 #endif
 
@@ -287,6 +306,7 @@ class Application {
 
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
+  EntityRegistry entities_{};
 
 #ifdef USE_BINARY_SENSOR
   std::vector<binary_sensor::BinarySensor *> binary_sensors_{};
@@ -330,6 +350,10 @@ class Application {
   bool name_add_mac_suffix_;
   uint32_t last_loop_{0};
   uint32_t loop_interval_{16};
+#ifdef USE_ESP32
+  /// The FreeRTOS task running setup() and loop(), woken up by wake_loop_threadsafe(). Set by enable_loop_wake().
+  void *loop_task_handle_{nullptr};
+#endif
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
 };
@@ -33,6 +33,8 @@ template<typename T, typename... X> class TemplatableValue {
   TemplatableValue(F f) : type_(LAMBDA), f_(f) {}
 
   bool has_value() { return this->type_ != EMPTY; }
+  /// Whether the value is computed by a lambda, so it can change without notice.
+  bool is_lambda() const { return this->type_ == LAMBDA; }
 
   T value(X... x) {
     if (this->type_ == LAMBDA) {
@@ -76,6 +78,12 @@ template<typename... Ts> class Condition {
   /// Check whether this condition passes. This condition check must be instant, and not cause any delays.
   virtual bool check(Ts... x) = 0;
 
+  /** Register a callback for when the result of check() may have changed.
+   *
+   * Returns false if the condition can't report changes, it then has to be checked periodically instead.
+   */
+  virtual bool add_on_change_callback(std::function<void()> &&callback) { return false; }
+
   /// Call check with a tuple of values as parameter.
   bool check_tuple(const std::tuple<Ts...> &tuple) {
     return this->check_tuple_(tuple, typename gens<sizeof...(Ts)>::type());
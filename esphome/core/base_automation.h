@@ -2,12 +2,23 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/scheduler.h"
+
+#include <memory>
 
 namespace esphome {
 
 template<typename... Ts> class AndCondition : public Condition<Ts...> {
  public:
   explicit AndCondition(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {}
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_change_callback(std::function<void()>(callback)))
+        return false;
+    }
+    return true;
+  }
   bool check(Ts... x) override {
     for (auto *condition : this->conditions_) {
       if (!condition->check(x...))
@@ -24,6 +35,13 @@ template<typename... Ts> class AndCondition : public Condition<Ts...> {
 template<typename... Ts> class OrCondition : public Condition<Ts...> {
  public:
   explicit OrCondition(const std::vector<Condition<Ts...> *> &conditions) : conditions_(conditions) {}
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    for (auto *condition : this->conditions_) {
+      if (!condition->add_on_change_callback(std::function<void()>(callback)))
+        return false;
+    }
+    return true;
+  }
   bool check(Ts... x) override {
     for (auto *condition : this->conditions_) {
       if (condition->check(x...))
@@ -40,6 +58,9 @@ template<typename... Ts> class OrCondition : public Condition<Ts...> {
 template<typename... Ts> class NotCondition : public Condition<Ts...> {
  public:
   explicit NotCondition(Condition<Ts...> *condition) : condition_(condition) {}
+  bool add_on_change_callback(std::function<void()> &&callback) override {
+    return this->condition_->add_on_change_callback(std::move(callback));
+  }
   bool check(Ts... x) override { return !this->condition_->check(x...); }
 
  protected:
@@ -102,6 +123,11 @@ class LoopTrigger : public Trigger<>, public Component {
   float get_setup_priority() const override { return setup_priority::DATA; }
 };
 
+/** Delay the following actions.
+ *
+ * Every run that is waiting takes a slot that holds its arguments and timer. Slots are reused once their delay is
+ * over, so a delay only allocates memory when more runs are waiting at the same time than ever before.
+ */
 template<typename... Ts> class DelayAction : public Action<Ts...>, public Component {
  public:
   explicit DelayAction() = default;
@@ -109,16 +135,41 @@ template<typename... Ts> class DelayAction : public Action<Ts...>, public Compon
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
+    Slot *slot = this->get_free_slot_();
+    slot->var = std::tie(x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    this->set_timer(&slot->timer, this->delay_.value(x...));
   }
   float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    for (auto &slot : this->slots_)
+      this->cancel_timer(&slot->timer);
+  }
+
+ protected:
+  struct Slot {
+    explicit Slot(std::function<void()> &&callback) : timer(std::move(callback)) {}
+
+    SchedulerTimer timer;
+    std::tuple<Ts...> var{};
+  };
+
+  Slot *get_free_slot_() {
+    for (auto &slot : this->slots_) {
+      if (!slot->timer.is_set())
+        return slot.get();
+    }
+    size_t index = this->slots_.size();
+    // play_next_() gets a copy of the arguments, so the slot is free to be reused while the next actions run
+    this->slots_.push_back(make_unique<Slot>([this, index]() { this->play_next_tuple_(this->slots_[index]->var); }));
+    return this->slots_.back().get();
+  }
+
+  std::vector<std::unique_ptr<Slot>> slots_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -199,7 +250,7 @@ template<typename... Ts> class WhileAction : public Action<Ts...> {
   void play_complex(Ts... x) override {
     this->num_running_++;
     // Store loop parameters
-    this->var_ = std::make_tuple(x...);
+    this->var_ = std::tie(x...);
     // Initial condition check
     if (!this->condition_->check_tuple(this->var_)) {
       // If new condition check failed, stop loop if running
@@ -241,7 +292,7 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
 
   void play_complex(Ts... x) override {
     this->num_running_++;
-    this->var_ = std::make_tuple(x...);
+    this->var_ = std::tie(x...);
     this->iteration_ = 0;
     this->then_.play_tuple(this->var_);
   }
@@ -257,12 +308,24 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
   std::tuple<Ts...> var_;
 };
 
+/** Wait until a condition is true.
+ *
+ * Conditions that report changes are only checked when they change, others are checked every loop while waiting.
+ */
 template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Component {
  public:
   WaitUntilAction(Condition<Ts...> *condition) : condition_(condition) {}
 
   TEMPLATABLE_VALUE(uint32_t, timeout_value)
 
+  void setup() override {
+    this->event_driven_ = this->condition_->add_on_change_callback([this]() {
+      // Check from the main loop, not while the change is being published
+      if (this->num_running_ > 0)
+        this->defer("check", [this]() { this->check_(); });
+    });
+  }
+
   void play_complex(Ts... x) override {
     this->num_running_++;
     // Check if we can continue immediately.
@@ -272,39 +335,46 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       }
       return;
     }
-    this->var_ = std::make_tuple(x...);
+    this->var_ = std::tie(x...);
 
-    if (this->timeout_value_.has_value()) {
-      auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
-    }
+    if (this->timeout_value_.has_value())
+      this->set_timer(&this->timeout_timer_, this->timeout_value_.value(x...));
+
+    if (!this->event_driven_)
+      this->set_interval("check", 0, [this]() { this->check_(); });
+  }
+
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  void play(Ts... x) override { /* ignore - see play_complex */
+  }
 
-    this->loop();
+  void stop() override {
+    this->cancel_timer(&this->timeout_timer_);
+    this->cancel_interval("check");
   }
 
-  void loop() override {
-    if (this->num_running_ == 0)
+ protected:
+  void check_() {
+    if (this->num_running_ == 0) {
+      this->cancel_interval("check");
       return;
+    }
 
     if (!this->condition_->check_tuple(this->var_)) {
       return;
     }
 
-    this->cancel_timeout("timeout");
+    this->cancel_timer(&this->timeout_timer_);
+    this->cancel_interval("check");
 
     this->play_next_tuple_(this->var_);
   }
 
-  float get_setup_priority() const override { return setup_priority::DATA; }
-
-  void play(Ts... x) override { /* ignore - see play_complex */
-  }
-
-  void stop() override { this->cancel_timeout("timeout"); }
-
- protected:
   Condition<Ts...> *condition_;
   std::tuple<Ts...> var_{};
+  SchedulerTimer timeout_timer_{[this]() { this->play_next_tuple_(this->var_); }};
+  bool event_driven_{false};
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
@@ -126,6 +126,12 @@ void Component::defer(const std::string &name, std::function<void()> &&f) {  //
 void Component::set_timeout(uint32_t timeout, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_timeout(this, "", timeout, std::move(f));
 }
+void Component::set_timer(SchedulerTimer *timer, uint32_t timeout) {  // NOLINT
+  App.scheduler.set_timer(this, timer, timeout);
+}
+bool Component::cancel_timer(SchedulerTimer *timer) {  // NOLINT
+  return App.scheduler.cancel_timer(timer);
+}
 void Component::set_interval(uint32_t interval, std::function<void()> &&f) {  // NOLINT
   App.scheduler.set_interval(this, "", interval, std::move(f));
 }
@@ -63,6 +63,8 @@ extern const uint32_t STATUS_LED_ERROR;
 
 enum RetryResult { DONE, RETRY };
 
+class SchedulerTimer;
+
 class Component {
  public:
   /** Where the component's initialization should happen.
@@ -237,6 +239,15 @@ class Component {
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
 
+  /** Set a timer owned by the caller to fire after timeout ms, without allocating memory.
+   *
+   * @see SchedulerTimer
+   */
+  void set_timer(SchedulerTimer *timer, uint32_t timeout);  // NOLINT
+
+  /// Cancel a timer set with set_timer(), returns whether it was set.
+  bool cancel_timer(SchedulerTimer *timer);  // NOLINT
+
   /** Defer a callback to the next loop() call.
    *
    * If name is specified and a defer() object with the same name exists, the old one is first removed.
@@ -8,110 +8,120 @@
 #endif
 
 namespace esphome {
-namespace api {
 
-class APIServer;
+#ifdef USE_API
+namespace api {
 class UserServiceDescriptor;
+}  // namespace api
+#endif
 
 class ComponentIterator {
  public:
-  ComponentIterator(APIServer *server);
-
-  void begin();
-  void advance();
-  virtual bool on_begin();
+  enum class IteratorState {
+    NONE = 0,
+    BEGIN,
 #ifdef USE_BINARY_SENSOR
-  virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
+    BINARY_SENSOR,
 #endif
 #ifdef USE_COVER
-  virtual bool on_cover(cover::Cover *cover) = 0;
+    COVER,
 #endif
 #ifdef USE_FAN
-  virtual bool on_fan(fan::Fan *fan) = 0;
+    FAN,
 #endif
 #ifdef USE_LIGHT
-  virtual bool on_light(light::LightState *light) = 0;
+    LIGHT,
 #endif
 #ifdef USE_SENSOR
-  virtual bool on_sensor(sensor::Sensor *sensor) = 0;
+    SENSOR,
 #endif
 #ifdef USE_SWITCH
-  virtual bool on_switch(switch_::Switch *a_switch) = 0;
+    SWITCH,
 #endif
 #ifdef USE_BUTTON
-  virtual bool on_button(button::Button *button) = 0;
+    BUTTON,
 #endif
 #ifdef USE_TEXT_SENSOR
-  virtual bool on_text_sensor(text_sensor::TextSensor *text_sensor) = 0;
+    TEXT_SENSOR,
+#endif
+#ifdef USE_API
+    SERVICE,
 #endif
-  virtual bool on_service(UserServiceDescriptor *service);
 #ifdef USE_ESP32_CAMERA
-  virtual bool on_camera(esp32_camera::ESP32Camera *camera);
+    CAMERA,
 #endif
 #ifdef USE_CLIMATE
-  virtual bool on_climate(climate::Climate *climate) = 0;
+    CLIMATE,
 #endif
 #ifdef USE_NUMBER
-  virtual bool on_number(number::Number *number) = 0;
+    NUMBER,
 #endif
 #ifdef USE_SELECT
-  virtual bool on_select(select::Select *select) = 0;
+    SELECT,
 #endif
 #ifdef USE_LOCK
-  virtual bool on_lock(lock::Lock *a_lock) = 0;
+    LOCK,
 #endif
-  virtual bool on_end();
+    MAX,
+  };
 
- protected:
-  enum class IteratorState {
-    NONE = 0,
-    BEGIN,
+  /** Restart the iteration from the first entity.
+   *
+   * @param include_internal Whether entities marked as internal should be visited as well.
+   */
+  void begin(bool include_internal = false);
+  void advance();
+  /// Whether an iteration has been started and has not finished yet.
+  bool is_running() const { return this->state_ != IteratorState::NONE; }
+  virtual bool on_begin();
 #ifdef USE_BINARY_SENSOR
-    BINARY_SENSOR,
+  virtual bool on_binary_sensor(binary_sensor::BinarySensor *binary_sensor) = 0;
 #endif
 #ifdef USE_COVER
-    COVER,
+  virtual bool on_cover(cover::Cover *cover) = 0;
 #endif
 #ifdef USE_FAN
-    FAN,
+  virtual bool on_fan(fan::Fan *fan) = 0;
 #endif
 #ifdef USE_LIGHT
-    LIGHT,
+  virtual bool on_light(light::LightState *light) = 0;
 #endif
 #ifdef USE_SENSOR
-    SENSOR,
+  virtual bool on_sensor(sensor::Sensor *sensor) = 0;
 #endif
 #ifdef USE_SWITCH
-    SWITCH,
+  virtual bool on_switch(switch_::Switch *a_switch) = 0;
 #endif
 #ifdef USE_BUTTON
-    BUTTON,
+  virtual bool on_button(button::Button *button) = 0;
 #endif
 #ifdef USE_TEXT_SENSOR
-    TEXT_SENSOR,
+  virtual bool on_text_sensor(text_sensor::TextSensor *text_sensor) = 0;
+#endif
+#ifdef USE_API
+  virtual bool on_service(api::UserServiceDescriptor *service);
 #endif
-    SERVICE,
 #ifdef USE_ESP32_CAMERA
-    CAMERA,
+  virtual bool on_camera(esp32_camera::ESP32Camera *camera);
 #endif
 #ifdef USE_CLIMATE
-    CLIMATE,
+  virtual bool on_climate(climate::Climate *climate) = 0;
 #endif
 #ifdef USE_NUMBER
-    NUMBER,
+  virtual bool on_number(number::Number *number) = 0;
 #endif
 #ifdef USE_SELECT
-    SELECT,
+  virtual bool on_select(select::Select *select) = 0;
 #endif
 #ifdef USE_LOCK
-    LOCK,
+  virtual bool on_lock(lock::Lock *a_lock) = 0;
 #endif
-    MAX,
-  } state_{IteratorState::NONE};
-  size_t at_{0};
+  virtual bool on_end();
 
-  APIServer *server_;
+ protected:
+  IteratorState state_{IteratorState::NONE};
+  size_t at_{0};
+  bool include_internal_{false};
 };
 
-}  // namespace api
 }  // namespace esphome
@@ -39,6 +39,6 @@ void EntityBase::calc_object_id_() {
   // FNV-1 hash
   this->object_id_hash_ = fnv1_hash(this->object_id_);
 }
-uint32_t EntityBase::get_object_id_hash() { return this->object_id_hash_; }
+uint32_t EntityBase::get_object_id_hash() const { return this->object_id_hash_; }
 
 }  // namespace esphome
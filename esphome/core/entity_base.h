@@ -25,7 +25,7 @@ class EntityBase {
   const std::string &get_object_id();
 
   // Get the unique Object ID of this Entity
-  uint32_t get_object_id_hash();
+  uint32_t get_object_id_hash() const;
 
   // Get/set whether this Entity should be hidden from outside of ESPHome
   bool is_internal() const;
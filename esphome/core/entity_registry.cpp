@@ -0,0 +1,66 @@
+#include "esphome/core/entity_registry.h"
+#include "esphome/core/helpers.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+
+void EntityRegistry::add(EntityType type, EntityBase *entity) {
+  if (!this->built_) {
+    this->entries_.push_back(Entry{0, type, entity});
+    return;
+  }
+  // Keep the index sorted; after the entries with the same key, so the first added entity still wins
+  const Entry entry{entity->get_object_id_hash(), type, entity};
+  auto it = std::upper_bound(this->entries_.begin(), this->entries_.end(), entry, EntityRegistry::entry_less_);
+  this->entries_.insert(it, entry);
+}
+
+bool EntityRegistry::entry_less_(const Entry &a, const Entry &b) {
+  if (a.key != b.key)
+    return a.key < b.key;
+  return a.type < b.type;
+}
+
+void EntityRegistry::build() {
+  // The key is only known once the entity has its name
+  for (auto &entry : this->entries_)
+    entry.key = entry.entity->get_object_id_hash();
+  this->entries_.shrink_to_fit();
+  // Stable, so that the first added entity wins if a key is used twice (like the old linear search)
+  std::stable_sort(this->entries_.begin(), this->entries_.end(), EntityRegistry::entry_less_);
+  this->built_ = true;
+}
+
+std::vector<EntityRegistry::Entry>::const_iterator EntityRegistry::lower_bound_(EntityType type, uint32_t key) const {
+  return std::lower_bound(this->entries_.begin(), this->entries_.end(), Entry{key, type, nullptr},
+                          EntityRegistry::entry_less_);
+}
+
+EntityBase *EntityRegistry::find(EntityType type, uint32_t key, bool include_internal) const {
+  for (auto it = this->lower_bound_(type, key); it != this->entries_.end(); ++it) {
+    if (it->key != key || it->type != type)
+      break;
+    if (include_internal || !it->entity->is_internal())
+      return it->entity;
+  }
+  return nullptr;
+}
+
+EntityBase *EntityRegistry::find(EntityType type, const char *object_id, size_t len, bool include_internal) const {
+  const uint32_t key = fnv1_hash(object_id, len);
+  for (auto it = this->lower_bound_(type, key); it != this->entries_.end(); ++it) {
+    if (it->key != key || it->type != type)
+      break;
+    if (!include_internal && it->entity->is_internal())
+      continue;
+    // Different object ids can have the same hash
+    const std::string &id = it->entity->get_object_id();
+    if (id.size() == len && memcmp(id.data(), object_id, len) == 0)
+      return it->entity;
+  }
+  return nullptr;
+}
+
+}  // namespace esphome
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "esphome/core/entity_base.h"
+
+namespace esphome {
+
+enum EntityType : uint8_t {
+  ENTITY_TYPE_BINARY_SENSOR = 0,
+  ENTITY_TYPE_SWITCH,
+  ENTITY_TYPE_BUTTON,
+  ENTITY_TYPE_SENSOR,
+  ENTITY_TYPE_TEXT_SENSOR,
+  ENTITY_TYPE_FAN,
+  ENTITY_TYPE_COVER,
+  ENTITY_TYPE_LIGHT,
+  ENTITY_TYPE_CLIMATE,
+  ENTITY_TYPE_NUMBER,
+  ENTITY_TYPE_SELECT,
+  ENTITY_TYPE_LOCK,
+};
+
+/** Index of all entities of the application by key (the hash of their object id) and type.
+ *
+ * Entities are added while the application is generated and the index is sorted once by build(), so looking up an
+ * entity by key or object id is a binary search instead of a scan through all entities of its type. If several
+ * entities of a type share a key, lookups return the first one that was added.
+ *
+ * The index must stay sorted for lookups, so an entity added after build() is inserted in order right away. Its name
+ * must already be set then, as that's where its key comes from.
+ */
+class EntityRegistry {
+ public:
+  void add(EntityType type, EntityBase *entity);
+  /// Sort the index, must be called after the entities generated for the application are added and before the first
+  /// lookup.
+  void build();
+
+  /// Find the entity of the given type with the given key, nullptr if there is none.
+  EntityBase *find(EntityType type, uint32_t key, bool include_internal = false) const;
+  /// Find the entity of the given type with the object id of len characters at object_id, nullptr if there is none.
+  EntityBase *find(EntityType type, const char *object_id, size_t len, bool include_internal = false) const;
+
+  size_t size() const { return this->entries_.size(); }
+
+ protected:
+  struct Entry {
+    uint32_t key;
+    EntityType type;
+    EntityBase *entity;
+  };
+
+  static bool entry_less_(const Entry &a, const Entry &b);
+  /// The first entry with the given key and type, or the end of the entries.
+  std::vector<Entry>::const_iterator lower_bound_(EntityType type, uint32_t key) const;
+
+  std::vector<Entry> entries_;
+  bool built_{false};
+};
+
+}  // namespace esphome
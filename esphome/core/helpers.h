@@ -151,6 +151,8 @@ uint8_t crc8(uint8_t *data, uint8_t len);
 
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
+/// Calculate a FNV-1 hash of the \p len characters at \p str.
+uint32_t fnv1_hash(const char *str, size_t len);
 
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
@@ -406,6 +408,8 @@ ParseOnOffState parse_on_off(const char *str, const char *on = nullptr, const ch
 
 /// Create a string from a value and an accuracy in decimals.
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals);
+/// Write a value with an accuracy in decimals to buf like value_accuracy_to_string(), returns the length written.
+size_t value_accuracy_to_buf(char *buf, size_t len, float value, int8_t accuracy_decimals);
 
 ///@}
 
@@ -30,6 +30,19 @@ class ESPPreferenceObject {
     return backend_->load(reinterpret_cast<uint8_t *>(dest), sizeof(T));
   }
 
+  /// Save len bytes, for data whose size is only known at runtime. len must match the length of the preference.
+  bool save(const uint8_t *data, size_t len) {
+    if (backend_ == nullptr)
+      return false;
+    return backend_->save(data, len);
+  }
+
+  bool load(uint8_t *data, size_t len) {
+    if (backend_ == nullptr)
+      return false;
+    return backend_->load(data, len);
+  }
+
  protected:
   ESPPreferenceBackend *backend_{nullptr};
 };
@@ -106,19 +106,42 @@ bool HOT Scheduler::cancel_retry(Component *component, const std::string &name)
   return this->cancel_item_(component, name, SchedulerItem::RETRY);
 }
 
+void HOT Scheduler::set_timer(Component *component, SchedulerTimer *timer, uint32_t timeout) {
+  timer->unlink_();
+  if (timeout == SCHEDULER_DONT_RUN)
+    return;
+
+  timer->component_ = component;
+  timer->start_ = this->millis_();
+  timer->timeout_ = timeout;
+  timer->link_(&this->timers_);
+}
+bool HOT Scheduler::cancel_timer(SchedulerTimer *timer) {
+  bool ret = timer->is_set();
+  timer->unlink_();
+  return ret;
+}
+
 optional<uint32_t> HOT Scheduler::next_schedule_in() {
-  if (this->empty_())
-    return {};
-  auto &item = this->items_[0];
   const uint32_t now = this->millis_();
-  uint32_t next_time = item->last_execution + item->interval;
-  if (next_time < now)
-    return 0;
-  return next_time - now;
+  optional<uint32_t> next_in;
+  if (!this->empty_()) {
+    auto &item = this->items_[0];
+    uint32_t next_time = item->last_execution + item->interval;
+    next_in = next_time < now ? 0 : next_time - now;
+  }
+  for (auto *timer = this->timers_; timer != nullptr; timer = timer->next_) {
+    uint32_t elapsed = now - timer->start_;
+    uint32_t remaining = elapsed >= timer->timeout_ ? 0 : timer->timeout_ - elapsed;
+    if (!next_in.has_value() || remaining < *next_in)
+      next_in = remaining;
+  }
+  return next_in;
 }
 void HOT Scheduler::call() {
   const uint32_t now = this->millis_();
   this->process_to_add();
+  this->call_timers_(now);
 
 #ifdef ESPHOME_DEBUG_SCHEDULER
   static uint32_t last_print = 0;
@@ -275,6 +298,48 @@ bool HOT Scheduler::cancel_item_(Component *component, const std::string &name,
 
   return ret;
 }
+void HOT Scheduler::call_timers_(uint32_t now) {
+  // Go through the timers that are set now, timers set by the callbacks are added to the (new) list and wait for the
+  // next call. Timers are unlinked before their callback runs, so callbacks may set or cancel any timer.
+  SchedulerTimer *pending = nullptr;
+  if (this->timers_ != nullptr) {
+    pending = this->timers_;
+    pending->pprev_ = &pending;
+    this->timers_ = nullptr;
+  }
+
+  while (pending != nullptr) {
+    SchedulerTimer *timer = pending;
+    timer->unlink_();
+    bool due = now - timer->start_ >= timer->timeout_;
+    if (!due) {
+      timer->link_(&this->timers_);
+      continue;
+    }
+    // Don't run on failed components
+    if (timer->component_ != nullptr && timer->component_->is_failed())
+      continue;
+
+    WarnIfComponentBlockingGuard guard{timer->component_};
+    timer->callback_();
+  }
+}
+void SchedulerTimer::link_(SchedulerTimer **head) {
+  this->next_ = *head;
+  if (this->next_ != nullptr)
+    this->next_->pprev_ = &this->next_;
+  this->pprev_ = head;
+  *head = this;
+}
+void SchedulerTimer::unlink_() {
+  if (this->pprev_ == nullptr)
+    return;
+  *this->pprev_ = this->next_;
+  if (this->next_ != nullptr)
+    this->next_->pprev_ = this->pprev_;
+  this->next_ = nullptr;
+  this->pprev_ = nullptr;
+}
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
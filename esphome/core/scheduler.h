@@ -8,6 +8,37 @@ namespace esphome {
 
 class Component;
 
+/** A timeout that is stored by its owner instead of by the scheduler.
+ *
+ * Setting and firing it doesn't allocate memory, which suits timeouts that are set very often, like the delays in
+ * automations. The owner has to keep the timer alive while it's set, destroying it cancels it. Set timers are kept in
+ * an unsorted list that is checked on every loop, so this is meant for a limited number of timers.
+ */
+class SchedulerTimer {
+ public:
+  explicit SchedulerTimer(std::function<void()> &&callback) : callback_(std::move(callback)) {}
+  SchedulerTimer(const SchedulerTimer &) = delete;
+  SchedulerTimer &operator=(const SchedulerTimer &) = delete;
+  ~SchedulerTimer() { this->unlink_(); }
+
+  /// Whether the timer is waiting to fire.
+  bool is_set() const { return this->pprev_ != nullptr; }
+
+ protected:
+  friend class Scheduler;
+
+  void link_(SchedulerTimer **head);
+  void unlink_();
+
+  std::function<void()> callback_;
+  Component *component_{nullptr};
+  uint32_t start_{0};
+  uint32_t timeout_{0};
+  SchedulerTimer *next_{nullptr};
+  /// The pointer that points to this timer, nullptr if it isn't set.
+  SchedulerTimer **pprev_{nullptr};
+};
+
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> &&func);
@@ -19,6 +50,11 @@ class Scheduler {
                  std::function<RetryResult()> &&func, float backoff_increase_factor = 1.0f);
   bool cancel_retry(Component *component, const std::string &name);
 
+  /// Set a timer to fire after timeout ms, replacing its previous timeout if it's still set.
+  void set_timer(Component *component, SchedulerTimer *timer, uint32_t timeout);
+  /// Cancel a timer, returns whether it was set.
+  bool cancel_timer(SchedulerTimer *timer);
+
   optional<uint32_t> next_schedule_in();
 
   void call();
@@ -75,6 +111,7 @@ class Scheduler {
   void pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
   bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  void call_timers_(uint32_t now);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -85,6 +122,7 @@ class Scheduler {
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
+  SchedulerTimer *timers_{nullptr};
 };
 
 }  // namespace esphome
@@ -0,0 +1,88 @@
+#include "esphome/core/state_journal.h"
+#include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+
+static const char *const TAG = "state_journal";
+
+bool StateJournalRecord::save(const uint8_t *data, size_t len) {
+  if (this->journal_ == nullptr)
+    return false;
+  return this->journal_->save_(this->index_, data, len);
+}
+
+bool StateJournalRecord::load(uint8_t *data, size_t len) {
+  if (this->journal_ == nullptr)
+    return false;
+  return this->journal_->load_(this->index_, data, len);
+}
+
+StateJournal::StateJournal() : flush_timer_([this]() { this->flush(); }) {}
+
+StateJournalRecord StateJournal::make_record(size_t length, uint32_t type) {
+  if (this->preferences_ == nullptr)
+    this->preferences_ = global_preferences;
+
+  Record record{};
+  record.pref = this->preferences_->make_preference(length, type);
+  record.offset = this->data_.size();
+  record.length = length;
+  this->records_.push_back(record);
+  this->data_.resize(this->data_.size() + length);
+  return StateJournalRecord(this, this->records_.size() - 1);
+}
+
+bool StateJournal::save_(size_t index, const uint8_t *data, size_t len) {
+  Record &record = this->records_[index];
+  if (len != record.length)
+    return false;
+  uint8_t *copy = &this->data_[record.offset];
+  if (record.stored && memcmp(copy, data, len) == 0)
+    return true;
+
+  memcpy(copy, data, len);
+  record.stored = false;
+  if (!record.dirty) {
+    record.dirty = true;
+    this->dirty_count_++;
+  }
+  // Write on the next loop iteration, so all changes made until then are written together
+  if (!this->flush_timer_.is_set())
+    App.scheduler.set_timer(nullptr, &this->flush_timer_, 0);
+  return true;
+}
+
+bool StateJournal::load_(size_t index, uint8_t *data, size_t len) {
+  Record &record = this->records_[index];
+  if (len != record.length)
+    return false;
+  uint8_t *copy = &this->data_[record.offset];
+  if (!record.dirty) {
+    if (!record.pref.load(copy, len))
+      return false;
+    record.stored = true;
+  }
+  memcpy(data, copy, len);
+  return true;
+}
+
+void StateJournal::flush() {
+  App.scheduler.cancel_timer(&this->flush_timer_);
+  if (this->dirty_count_ == 0)
+    return;
+
+  ESP_LOGVV(TAG, "Writing %zu records", this->dirty_count_);
+  for (auto &record : this->records_) {
+    if (!record.dirty)
+      continue;
+    record.dirty = false;
+    record.stored = record.pref.save(&this->data_[record.offset], record.length);
+    this->write_count_++;
+  }
+  this->dirty_count_ = 0;
+}
+
+StateJournal global_state_journal;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esphome
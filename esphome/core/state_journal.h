@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "esphome/core/preferences.h"
+#include "esphome/core/scheduler.h"
+
+namespace esphome {
+
+class StateJournal;
+
+/** A fixed-size restore record of an entity, kept by the StateJournal.
+ *
+ * Has the same interface as ESPPreferenceObject, but save() only copies the data into RAM and marks the record dirty.
+ * Saving data that equals the data that was last saved or loaded does nothing.
+ */
+class StateJournalRecord {
+ public:
+  StateJournalRecord() = default;
+  StateJournalRecord(StateJournal *journal, size_t index) : journal_(journal), index_(index) {}
+
+  template<typename T> bool save(const T *src) {
+    return this->save(reinterpret_cast<const uint8_t *>(src), sizeof(T));
+  }
+  template<typename T> bool load(T *dest) { return this->load(reinterpret_cast<uint8_t *>(dest), sizeof(T)); }
+
+  bool save(const uint8_t *data, size_t len);
+  bool load(uint8_t *data, size_t len);
+
+ protected:
+  StateJournal *journal_{nullptr};
+  size_t index_{0};
+};
+
+/** Coalesces saving the restore state of entities.
+ *
+ * Entities like lights, fans, covers and climates save their state on every change. Instead of writing to the
+ * preferences backend each time, their records are kept in one block in RAM and the records that changed are written
+ * together on the next loop iteration, or right away when the preferences are synced. A scene that changes many
+ * entities, or a slider that changes one entity many times, results in at most one write per record.
+ *
+ * Every record keeps its own preference, so state saved before the journal existed is still restored.
+ */
+class StateJournal {
+ public:
+  StateJournal();
+
+  /// Create a record of length bytes, stored in a preference of the given type.
+  StateJournalRecord make_record(size_t length, uint32_t type);
+  template<typename T> StateJournalRecord make_record(uint32_t type) { return this->make_record(sizeof(T), type); }
+
+  /// Write all dirty records to the preferences backend.
+  void flush();
+  bool has_dirty() const { return this->dirty_count_ != 0; }
+
+  /// Use other preferences than global_preferences, must be called before any record is made.
+  void set_preferences(ESPPreferences *preferences) { this->preferences_ = preferences; }
+  /// Number of records written to the preferences backend so far.
+  uint32_t get_write_count() const { return this->write_count_; }
+
+ protected:
+  friend StateJournalRecord;
+
+  struct Record {
+    ESPPreferenceObject pref;
+    /// Offset of the data of this record in data_.
+    uint32_t offset;
+    uint16_t length;
+    /// The data was changed since it was last written.
+    bool dirty;
+    /// The data equals what's stored in the preference, because it was loaded from or written to it.
+    bool stored;
+  };
+
+  bool save_(size_t index, const uint8_t *data, size_t len);
+  bool load_(size_t index, uint8_t *data, size_t len);
+
+  ESPPreferences *preferences_{nullptr};
+  std::vector<Record> records_;
+  /// The data of all records, one after another.
+  std::vector<uint8_t> data_;
+  size_t dirty_count_{0};
+  uint32_t write_count_{0};
+  SchedulerTimer flush_timer_;
+};
+
+extern StateJournal global_state_journal;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace esphome
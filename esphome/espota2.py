@@ -1,7 +1,9 @@
 import hashlib
 import logging
+import os
 import random
 import socket
+import struct
 import sys
 import time
 import gzip
@@ -19,6 +21,7 @@ RESPONSE_BIN_MD5_OK = 67
 RESPONSE_RECEIVE_OK = 68
 RESPONSE_UPDATE_END_OK = 69
 RESPONSE_SUPPORTS_COMPRESSION = 70
+RESPONSE_SUPPORTS_DELTA = 71
 
 RESPONSE_ERROR_MAGIC = 128
 RESPONSE_ERROR_UPDATE_PREPARE = 129
@@ -30,6 +33,7 @@ RESPONSE_ERROR_WRONG_CURRENT_FLASH_CONFIG = 134
 RESPONSE_ERROR_WRONG_NEW_FLASH_CONFIG = 135
 RESPONSE_ERROR_ESP8266_NOT_ENOUGH_SPACE = 136
 RESPONSE_ERROR_ESP32_NOT_ENOUGH_SPACE = 137
+RESPONSE_ERROR_INVALID_DELTA = 139
 RESPONSE_ERROR_UNKNOWN = 255
 
 OTA_VERSION_1_0 = 1
@@ -37,6 +41,28 @@ OTA_VERSION_1_0 = 1
 MAGIC_BYTES = [0x6C, 0x26, 0xF7, 0x5C, 0x45]
 
 FEATURE_SUPPORTS_COMPRESSION = 0x01
+FEATURE_SUPPORTS_DELTA = 0x02
+
+OTA_MODE_FULL = 0
+OTA_MODE_DELTA = 1
+# Sent after authentication to request the MD5 of the running image
+OTA_MODE_QUERY_BASE = 2
+
+# Patch format, see esphome/components/ota/ota_delta.h
+DELTA_MAGIC = b"EDL1"
+DELTA_OP_END = 0x00
+DELTA_OP_COPY = 0x01
+DELTA_OP_DATA = 0x02
+# Length of the blocks matched between the images, shorter matches aren't worth
+# the 9 bytes of a copy operation
+DELTA_BLOCK_SIZE = 32
+# The base image is indexed every DELTA_INDEX_STEP bytes, so every common region
+# of at least DELTA_BLOCK_SIZE + DELTA_INDEX_STEP - 1 bytes is found
+DELTA_INDEX_STEP = 16
+# Successfully uploaded images are kept next to the firmware file to serve as
+# base of the next delta update
+DELTA_CACHE_DIR = "ota_images"
+DELTA_CACHE_SIZE = 3
 
 _LOGGER = logging.getLogger(__name__)
 
@@ -151,6 +177,10 @@ def check_error(data, expect):
             "Error: The OTA partition on the ESP is too small. ESPHome needs to resize "
             "this partition, please flash over USB."
         )
+    if dat == RESPONSE_ERROR_INVALID_DELTA:
+        raise OTAError(
+            "Error: The ESP rejected the delta update. Please try uploading again."
+        )
     if dat == RESPONSE_ERROR_UNKNOWN:
         raise OTAError("Unknown error from ESP")
     if not isinstance(expect, (list, tuple)):
@@ -159,6 +189,135 @@ def check_error(data, expect):
         raise OTAError(f"Unexpected response from ESP: 0x{data[0]:02X}")
 
 
+def _append_delta_data(patch, data):
+    if data:
+        patch += struct.pack(">BI", DELTA_OP_DATA, len(data))
+        patch += data
+
+
+def generate_delta(base, target):
+    """Generate a patch that turns the base image into the target image."""
+    index = {}
+    for pos in range(0, len(base) - DELTA_BLOCK_SIZE + 1, DELTA_INDEX_STEP):
+        index.setdefault(base[pos : pos + DELTA_BLOCK_SIZE], pos)
+
+    patch = bytearray(DELTA_MAGIC)
+    literal_start = 0
+    pos = 0
+    while pos + DELTA_BLOCK_SIZE <= len(target):
+        base_pos = index.get(target[pos : pos + DELTA_BLOCK_SIZE])
+        if base_pos is None:
+            pos += 1
+            continue
+
+        # Extend the match backwards into the pending literal data, and forwards
+        start = pos
+        while (
+            start > literal_start
+            and base_pos > 0
+            and base[base_pos - 1] == target[start - 1]
+        ):
+            start -= 1
+            base_pos -= 1
+        length = pos - start + DELTA_BLOCK_SIZE
+        max_length = min(len(base) - base_pos, len(target) - start)
+        while (
+            length + 256 <= max_length
+            and base[base_pos + length : base_pos + length + 256]
+            == target[start + length : start + length + 256]
+        ):
+            length += 256
+        while (
+            length < max_length and base[base_pos + length] == target[start + length]
+        ):
+            length += 1
+
+        _append_delta_data(patch, target[literal_start:start])
+        patch += struct.pack(">BII", DELTA_OP_COPY, base_pos, length)
+        pos = literal_start = start + length
+
+    _append_delta_data(patch, target[literal_start:])
+    patch.append(DELTA_OP_END)
+    return bytes(patch)
+
+
+def apply_delta(base, patch):
+    """Apply a patch generated by generate_delta(), like the device does."""
+    if patch[: len(DELTA_MAGIC)] != DELTA_MAGIC:
+        raise ValueError("Invalid patch magic")
+    result = bytearray()
+    pos = len(DELTA_MAGIC)
+    while True:
+        opcode = patch[pos]
+        pos += 1
+        if opcode == DELTA_OP_END:
+            break
+        if opcode == DELTA_OP_COPY:
+            offset, length = struct.unpack_from(">II", patch, pos)
+            pos += 8
+            if offset + length > len(base):
+                raise ValueError("Copy outside of the base image")
+            result += base[offset : offset + length]
+        elif opcode == DELTA_OP_DATA:
+            (length,) = struct.unpack_from(">I", patch, pos)
+            pos += 4
+            result += patch[pos : pos + length]
+            pos += length
+        else:
+            raise ValueError(f"Unknown patch operation 0x{opcode:02X}")
+    if pos != len(patch):
+        raise ValueError("Data after the end of the patch")
+    return bytes(result)
+
+
+def _delta_cache_dir(filename):
+    return os.path.join(os.path.dirname(os.path.abspath(filename)), DELTA_CACHE_DIR)
+
+
+def has_delta_base(filename):
+    """Whether any previously uploaded image of this device is cached."""
+    try:
+        return any(
+            name.endswith(".bin") for name in os.listdir(_delta_cache_dir(filename))
+        )
+    except OSError:
+        return False
+
+
+def load_delta_base(filename, md5):
+    """Load a previously uploaded image by its MD5, or None if it isn't known."""
+    path = os.path.join(_delta_cache_dir(filename), f"{md5}.bin")
+    try:
+        with open(path, "rb") as file_handle:
+            base = file_handle.read()
+    except OSError:
+        return None
+    if hashlib.md5(base).hexdigest() != md5:
+        return None
+    return base
+
+
+def store_delta_base(filename, contents):
+    """Keep an uploaded image to serve as base of the next delta update."""
+    cache_dir = _delta_cache_dir(filename)
+    md5 = hashlib.md5(contents).hexdigest()
+    try:
+        os.makedirs(cache_dir, exist_ok=True)
+        path = os.path.join(cache_dir, f"{md5}.bin")
+        with open(path, "wb") as file_handle:
+            file_handle.write(contents)
+        # Remove the oldest images, but never the one just stored
+        others = sorted(
+            (os.path.join(cache_dir, name) for name in os.listdir(cache_dir)),
+            key=os.path.getmtime,
+        )
+        others.remove(path)
+        for old_path in others[: len(others) - DELTA_CACHE_SIZE + 1]:
+            os.remove(old_path)
+    except OSError as err:
+        _LOGGER.debug("Storing image for delta updates failed: %s", err)
+
+
 def send_check(sock, data, msg):
     try:
         if isinstance(data, (list, tuple)):
@@ -187,11 +346,21 @@ def perform_ota(sock, password, file_handle, filename):
         raise OTAError(f"Unsupported OTA version {version}")
 
     # Features
-    send_check(sock, FEATURE_SUPPORTS_COMPRESSION, "features")
+    send_check(
+        sock, FEATURE_SUPPORTS_COMPRESSION | FEATURE_SUPPORTS_DELTA, "features"
+    )
     features = receive_exactly(
-        sock, 1, "features", [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION]
+        sock,
+        1,
+        "features",
+        [RESPONSE_HEADER_OK, RESPONSE_SUPPORTS_COMPRESSION, RESPONSE_SUPPORTS_DELTA],
     )[0]
 
+    delta_offered = features == RESPONSE_SUPPORTS_DELTA
+    if delta_offered:
+        # The actual header response follows
+        features = receive_exactly(sock, 1, "features", [], decode=False)[0]
+
     if features == RESPONSE_SUPPORTS_COMPRESSION:
         upload_contents = gzip.compress(file_contents, compresslevel=9)
         _LOGGER.info("Compressed to %s bytes", len(upload_contents))
@@ -223,17 +392,43 @@ def perform_ota(sock, password, file_handle, filename):
         send_check(sock, result, "auth result")
         receive_exactly(sock, 1, "auth result", RESPONSE_AUTH_OK)
 
-    upload_size = len(upload_contents)
-    upload_size_encoded = [
-        (upload_size >> 24) & 0xFF,
-        (upload_size >> 16) & 0xFF,
-        (upload_size >> 8) & 0xFF,
-        (upload_size >> 0) & 0xFF,
+    patch = None
+    if delta_offered and has_delta_base(filename):
+        # Only ask for the MD5 of the running image when it can be used,
+        # the ESP has to read the whole image to calculate it
+        send_check(sock, OTA_MODE_QUERY_BASE, "update mode")
+        base_md5 = receive_exactly(
+            sock, 32, "running image MD5", [], decode=False
+        ).decode()
+        _LOGGER.debug("MD5 of running image is %s", base_md5)
+        base = load_delta_base(filename, base_md5)
+        if base is not None:
+            patch = generate_delta(base, file_contents)
+            # Never send a patch that doesn't produce the expected image
+            if apply_delta(base, patch) != file_contents:
+                patch = None
+
+    use_delta = patch is not None and len(patch) < len(upload_contents)
+    if use_delta:
+        _LOGGER.info("Sending delta update of %s bytes", len(patch))
+    if delta_offered:
+        send_check(
+            sock, OTA_MODE_DELTA if use_delta else OTA_MODE_FULL, "update mode"
+        )
+
+    # A delta update is checked against the size and MD5 of the resulting image
+    image_contents = file_contents if use_delta else upload_contents
+    image_size = len(image_contents)
+    image_size_encoded = [
+        (image_size >> 24) & 0xFF,
+        (image_size >> 16) & 0xFF,
+        (image_size >> 8) & 0xFF,
+        (image_size >> 0) & 0xFF,
     ]
-    send_check(sock, upload_size_encoded, "binary size")
+    send_check(sock, image_size_encoded, "binary size")
     receive_exactly(sock, 1, "binary size", RESPONSE_UPDATE_PREPARE_OK)
 
-    upload_md5 = hashlib.md5(upload_contents).hexdigest()
+    upload_md5 = hashlib.md5(image_contents).hexdigest()
     _LOGGER.debug("MD5 of upload is %s", upload_md5)
 
     send_check(sock, upload_md5, "file checksum")
@@ -247,6 +442,9 @@ def perform_ota(sock, password, file_handle, filename):
     # Set higher timeout during upload
     sock.settimeout(20.0)
 
+    if use_delta:
+        upload_contents = patch
+    upload_size = len(upload_contents)
     offset = 0
     progress = ProgressBar()
     while True:
@@ -274,6 +472,7 @@ def perform_ota(sock, password, file_handle, filename):
     send_check(sock, RESPONSE_OK, "end acknowledgement")
 
     _LOGGER.info("OTA successful")
+    store_delta_base(filename, file_contents)
 
     # Do not connect logs until it is fully on
     time.sleep(1)
@@ -0,0 +1,132 @@
+#include "host.h"
+
+#include "esphome/core/application.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <strings.h>
+
+namespace esphome {
+
+namespace host_test {
+
+static uint32_t current_time = 0;       // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static int warnings = 0;                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static int checks = 0;                  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static int failures = 0;                // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static RamPreferences ram_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+class RamPreferences::Backend : public ESPPreferenceBackend {
+ public:
+  Backend(RamPreferences *parent, uint32_t type) : parent_(parent), type_(type) {}
+
+  bool save(const uint8_t *data, size_t len) override {
+    this->parent_->data[this->type_].assign(data, data + len);
+    this->parent_->writes++;
+    return true;
+  }
+  bool load(uint8_t *data, size_t len) override {
+    auto &saved = this->parent_->data[this->type_];
+    if (saved.size() != len)
+      return false;
+    memcpy(data, saved.data(), len);
+    return true;
+  }
+
+ protected:
+  RamPreferences *parent_;
+  uint32_t type_;
+};
+
+ESPPreferenceObject RamPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
+  return this->make_preference(length, type);
+}
+ESPPreferenceObject RamPreferences::make_preference(size_t length, uint32_t type) {
+  this->backends_.push_back(make_unique<Backend>(this, type));
+  return this->backends_.back().get();
+}
+bool RamPreferences::sync() {
+  this->syncs++;
+  return true;
+}
+
+RamPreferences &preferences() { return ram_preferences; }
+
+void advance_to(uint32_t time_ms) {
+  current_time = time_ms;
+  App.scheduler.call();
+}
+uint32_t now() { return current_time; }
+
+int logged_warnings() { return warnings; }
+
+void expect(bool ok, const char *expression, const char *file, int line) {
+  checks++;
+  if (ok)
+    return;
+  failures++;
+  printf("%s:%d: check failed: %s\n", file, line, expression);
+}
+
+int finish() {
+  printf("%d of %d checks passed\n", checks - failures, checks);
+  return failures == 0 ? 0 : 1;
+}
+
+}  // namespace host_test
+
+// Normally provided by application.cpp, the platform and helpers.cpp, which can't be built on the host.
+
+Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+ESPPreferences *global_preferences = &host_test::ram_preferences;  // NOLINT
+
+uint32_t millis() { return host_test::current_time; }
+uint32_t random_uint32() { return 4; }
+
+uint32_t fnv1_hash(const std::string &str) { return fnv1_hash(str.data(), str.size()); }
+uint32_t fnv1_hash(const char *str, size_t len) {
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < len; i++) {
+    hash *= 16777619UL;
+    hash ^= str[i];
+  }
+  return hash;
+}
+bool str_equals_case_insensitive(const std::string &a, const std::string &b) {
+  return strcasecmp(a.c_str(), b.c_str()) == 0;
+}
+std::string str_snake_case(const std::string &str) {
+  std::string result;
+  result.resize(str.length());
+  std::transform(str.begin(), str.end(), result.begin(), ::tolower);
+  std::replace(result.begin(), result.end(), ' ', '_');
+  return result;
+}
+std::string str_sanitize(const std::string &str) {
+  std::string out;
+  std::copy_if(str.begin(), str.end(), std::back_inserter(out), [](const char &c) {
+    return c == '-' || c == '_' || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+  });
+  return out;
+}
+
+void esp_log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  if (level > ESPHOME_LOG_LEVEL_WARN)
+    return;
+  host_test::warnings++;
+  printf("[%s:%d] ", tag, line);
+  vprintf(format, args);
+  printf("\n");
+}
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  va_list args;
+  va_start(args, format);
+  esp_log_vprintf_(level, tag, line, format, args);
+  va_end(args);
+}
+
+}  // namespace esphome
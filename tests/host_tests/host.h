@@ -0,0 +1,53 @@
+#pragma once
+
+// Support for running component logic on the host, see script/host_test. It provides what the platform and the
+// code generated from the configuration would otherwise provide: the time, logging, preferences and the scheduler.
+
+#include "esphome/core/preferences.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace host_test {
+
+/// Preferences kept in memory, so tests can look at what was saved and how often.
+class RamPreferences : public ESPPreferences {
+ public:
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override;
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override;
+  bool sync() override;
+
+  /// The saved data of each preference type, empty if it was never saved.
+  std::map<uint32_t, std::vector<uint8_t>> data;
+  /// The number of saves so far.
+  int writes{0};
+  /// The number of syncs so far.
+  int syncs{0};
+
+ protected:
+  class Backend;
+  std::vector<std::unique_ptr<Backend>> backends_;
+};
+
+/// The preferences installed as global_preferences.
+RamPreferences &preferences();
+
+/// Set the time returned by millis() and run the scheduler, so everything that is due by then runs.
+void advance_to(uint32_t time_ms);
+uint32_t now();
+
+/// The number of warnings and errors logged so far.
+int logged_warnings();
+
+/// Record the result of a check, failures are printed with their location.
+void expect(bool ok, const char *expression, const char *file, int line);
+/// Print a summary of the checks, returns the exit code of the test.
+int finish();
+
+}  // namespace host_test
+}  // namespace esphome
+
+#define EXPECT(expression) ::esphome::host_test::expect((expression), #expression, __FILE__, __LINE__)
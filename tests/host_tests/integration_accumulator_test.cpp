@@ -0,0 +1,197 @@
+#include "host.h"
+
+#include "esphome/components/integration/accumulator.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace esphome;
+using namespace esphome::integration;
+using host_test::preferences;
+
+static const uint32_t MS_PER_HOUR = 3600000;
+
+/// Round a value to the resolution the accumulator works in, to compute the exact expected totals.
+static double quantize(float value) {
+  return double(llroundf(value * (1UL << Accumulator::FRACTIONAL_BITS))) / (1UL << Accumulator::FRACTIONAL_BITS);
+}
+
+/// A constant load over a month of samples every second, adds up without any drift.
+static void test_constant_load() {
+  Accumulator accumulator;
+  accumulator.set_time_unit(MS_PER_HOUR);
+  accumulator.start(0);
+  accumulator.add_sample(0, 1000.25f);
+  for (uint32_t time = 1000; time <= 30UL * 24 * MS_PER_HOUR; time += 1000)
+    accumulator.add_sample(time, 1000.25f);
+  EXPECT(accumulator.get_total() == 1000.25 * 30 * 24);
+}
+
+/// A ramp, for which all methods have an exact expected total.
+static void test_ramp() {
+  const IntegrationMethod methods[] = {INTEGRATION_METHOD_TRAPEZOID, INTEGRATION_METHOD_LEFT,
+                                       INTEGRATION_METHOD_RIGHT};
+  for (auto method : methods) {
+    Accumulator accumulator;
+    accumulator.set_method(method);
+    accumulator.set_time_unit(1000);
+    accumulator.start(0);
+    double expected = 0;
+    float previous = 0;
+    for (uint32_t i = 0; i <= 100000; i++) {
+      float value = i / 64.0f;
+      accumulator.add_sample(i * 250, value);
+      double height = method == INTEGRATION_METHOD_LEFT    ? previous
+                      : method == INTEGRATION_METHOD_RIGHT ? value
+                                                           : (previous + value) / 2;
+      expected += height * 0.25;
+      previous = value;
+    }
+    EXPECT(accumulator.get_total() == expected);
+  }
+}
+
+/// A daily load curve with jittering sample times, compared with the exact sum of the rounded samples.
+static void test_load_curve() {
+  Accumulator single, batch;
+  single.set_time_unit(MS_PER_HOUR);
+  batch.set_time_unit(MS_PER_HOUR);
+  // Start just before millis() rolls over
+  const uint32_t start = UINT32_MAX - 3600000;
+  single.start(start);
+  batch.start(start);
+
+  std::vector<Accumulator::Sample> samples;
+  double expected = 0;
+  double previous = 0;
+  uint32_t elapsed = 0;
+  for (uint32_t i = 1; elapsed < 24 * MS_PER_HOUR; i++) {
+    uint32_t step = 900 + (i * 7919) % 200;
+    elapsed += step;
+    float value = 300.0f + 2500.0f * std::max(0.0f, sinf(elapsed * 3.14159265f / (12 * MS_PER_HOUR))) +
+                  40.0f * sinf(i * 0.37f);
+    single.add_sample(start + elapsed, value);
+    samples.push_back(Accumulator::Sample{start + elapsed, value});
+    expected += (previous + quantize(value)) / 2 * step / MS_PER_HOUR;
+    previous = quantize(value);
+  }
+  for (size_t i = 0; i < samples.size(); i += 64)
+    batch.add_samples(&samples[i], std::min<size_t>(64, samples.size() - i));
+
+  EXPECT(std::abs(single.get_total() - expected) < 1e-6);
+  int64_t single_whole, batch_whole;
+  uint32_t single_fraction, batch_fraction;
+  single.get_total(single_whole, single_fraction);
+  batch.get_total(batch_whole, batch_fraction);
+  EXPECT(single_whole == batch_whole && single_fraction == batch_fraction);
+}
+
+/// Values outside of the range or the resolution are logged once.
+static void test_limits() {
+  Accumulator accumulator;
+  accumulator.set_time_unit(1000);
+  accumulator.start(0);
+  int warnings = host_test::logged_warnings();
+  accumulator.add_sample(1000, 5e6f);
+  accumulator.add_sample(2000, 6e6f);
+  EXPECT(host_test::logged_warnings() == warnings + 1);
+  EXPECT(accumulator.get_total() == 4194304.0 / 2 + 4194304.0);
+  accumulator.add_sample(3000, 1e-7f);
+  accumulator.add_sample(4000, 1e-7f);
+  EXPECT(host_test::logged_warnings() == warnings + 2);
+  accumulator.add_sample(5000, NAN);
+  EXPECT(accumulator.get_total() == 4194304.0 / 2 + 4194304.0 + 4194304.0 / 2);
+}
+
+/// Totals survive a restart, growing the number of records and are restored from the old float preferences.
+static void test_store() {
+  auto &prefs = preferences();
+  float legacy = 12.5f;
+  prefs.data[3].assign(reinterpret_cast<uint8_t *>(&legacy), reinterpret_cast<uint8_t *>(&legacy) + sizeof(legacy));
+
+  std::vector<Accumulator> first(8);
+  {
+    AccumulatorStore store;
+    for (uint32_t i = 0; i < first.size(); i++) {
+      first[i].set_time_unit(1000);
+      store.add(i + 1, &first[i], 0);
+    }
+    for (auto &accumulator : first)
+      store.restore(&accumulator);
+    EXPECT(first[2].get_total() == 12.5);
+
+    first[0].set_total(int64_t(1) << 40, 1UL << 31);
+    first[1].set_total(-1.25);
+    store.mark_dirty();
+    int writes = prefs.writes;
+    host_test::advance_to(host_test::now() + 10);
+    EXPECT(prefs.writes == writes + 1);
+  }
+
+  // A 9th sensor adds a record and keeps the first one
+  std::vector<Accumulator> second(9);
+  AccumulatorStore store;
+  for (uint32_t i = 0; i < second.size(); i++) {
+    second[i].set_time_unit(1000);
+    store.add(i + 1, &second[i], 0);
+  }
+  for (auto &accumulator : second)
+    store.restore(&accumulator);
+  int64_t whole;
+  uint32_t fraction;
+  second[0].get_total(whole, fraction);
+  EXPECT(whole == (int64_t(1) << 40) && fraction == 1UL << 31);
+  second[1].get_total(whole, fraction);
+  EXPECT(whole == -2 && fraction == 3UL << 30);
+  EXPECT(second[2].get_total() == 12.5);
+
+  // Only the record that changed is written
+  second[8].set_total(3.0);
+  store.mark_dirty();
+  int writes = prefs.writes;
+  host_test::advance_to(host_test::now() + 10);
+  EXPECT(prefs.writes == writes + 1);
+}
+
+/// A change within the minimum save interval is saved and synced on shutdown.
+static void test_shutdown() {
+  auto &prefs = preferences();
+  Accumulator accumulator;
+  accumulator.set_time_unit(1000);
+  AccumulatorStore store;
+  store.add(100, &accumulator, 60000);
+  store.restore(&accumulator);
+
+  accumulator.set_total(7.0);
+  store.mark_dirty();
+  int writes = prefs.writes;
+  int syncs = prefs.syncs;
+  store.on_safe_shutdown();
+  store.on_shutdown();
+  EXPECT(prefs.writes == writes + 1);
+  EXPECT(prefs.syncs == syncs);
+
+  accumulator.set_total(8.0);
+  store.mark_dirty();
+  store.on_shutdown();
+  EXPECT(prefs.writes == writes + 2);
+  EXPECT(prefs.syncs == syncs + 1);
+
+  Accumulator restored;
+  restored.set_time_unit(1000);
+  AccumulatorStore restarted;
+  restarted.add(100, &restored, 60000);
+  restarted.restore(&restored);
+  EXPECT(restored.get_total() == 8.0);
+}
+
+int main() {
+  test_constant_load();
+  test_ramp();
+  test_load_curve();
+  test_limits();
+  test_store();
+  test_shutdown();
+  return host_test::finish();
+}
@@ -0,0 +1,135 @@
+#include "host.h"
+
+#include "esphome/components/thermostat/thermostat_climate.h"
+
+#include <cmath>
+#include <cstdio>
+
+using namespace esphome;
+using namespace esphome::thermostat;
+using climate::ClimateAction;
+
+static const float LOW = 20.0f;
+static const float HIGH = 24.0f;
+static const float DEADBAND = 0.5f;
+static const float OVERRUN = 0.3f;
+
+/// A thermostat that heats and cools between two set points, the test sets its sensor and timers. Like components on
+/// the device it's never destroyed, as the scheduler may still hold its timeouts.
+class TestThermostat {
+ public:
+  TestThermostat(const std::string &name, climate::ClimateMode mode) {
+    // Each test uses its own name, otherwise it restores the state another one saved
+    this->thermostat.set_name(name);
+    this->thermostat.set_sensor(&this->sensor);
+    this->thermostat.set_supports_cool(true);
+    this->thermostat.set_supports_heat(true);
+    this->thermostat.set_supports_heat_cool(true);
+    this->thermostat.set_supports_two_points(true);
+    this->thermostat.set_cool_deadband(DEADBAND);
+    this->thermostat.set_cool_overrun(OVERRUN);
+    this->thermostat.set_heat_deadband(DEADBAND);
+    this->thermostat.set_heat_overrun(OVERRUN);
+    this->thermostat.set_normal_config(ThermostatClimateTargetTempConfig(LOW, HIGH));
+    this->thermostat.set_default_mode(mode);
+    this->thermostat.add_on_state_callback([this]() { this->publishes++; });
+  }
+
+  void setup() {
+    this->thermostat.setup();
+    this->publishes = 0;
+  }
+  void set_temperature(uint32_t time, float temperature) {
+    host_test::advance_to(time);
+    this->sensor.publish_state(temperature);
+  }
+  ClimateAction action() const { return this->thermostat.action; }
+
+  sensor::Sensor sensor;
+  ThermostatClimate thermostat;
+  int publishes{0};
+};
+
+/// The action the thermostat should take, from the documented thresholds of both demands.
+static ClimateAction expected_action(climate::ClimateMode mode, float temperature, ClimateAction previous) {
+  bool cool = temperature > HIGH + DEADBAND ||
+              (previous == climate::CLIMATE_ACTION_COOLING && temperature >= HIGH - OVERRUN);
+  bool heat = temperature < LOW - DEADBAND ||
+              (previous == climate::CLIMATE_ACTION_HEATING && temperature <= LOW + OVERRUN);
+  if (mode == climate::CLIMATE_MODE_COOL)
+    heat = false;
+  if (mode == climate::CLIMATE_MODE_HEAT)
+    cool = false;
+  if (cool && !heat)
+    return climate::CLIMATE_ACTION_COOLING;
+  if (heat && !cool)
+    return climate::CLIMATE_ACTION_HEATING;
+  return climate::CLIMATE_ACTION_IDLE;
+}
+
+/// Replay a long temperature trace and compare every action with the expected one. The temperature is rounded like a
+/// sensor would, so it often repeats and the state must only be published when the temperature or action changed.
+static void test_trace(const std::string &name, climate::ClimateMode mode) {
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  auto &test = *new TestThermostat(name, mode);
+  test.setup();
+
+  uint32_t seed = 12345;
+  float temperature = 22.0f;
+  float previous_temperature = NAN;
+  ClimateAction previous_action = test.action();
+  int expected_publishes = 0;
+  int mismatches = 0;
+  for (uint32_t i = 0; i < 20000; i++) {
+    seed = seed * 1103515245UL + 12345UL;
+    float step = (int32_t((seed >> 16) % 7) - 3) * 0.1f;
+    if (temperature + step < 17.0f || temperature + step > 27.0f)
+      step = -step;
+    temperature = roundf((temperature + step) * 10.0f) / 10.0f;
+
+    ClimateAction expected = expected_action(mode, temperature, previous_action);
+    test.set_temperature(i * 1000, temperature);
+    if (test.action() != expected && mismatches++ < 5)
+      printf("Step %u at %.1f: action %d, expected %d\n", i, temperature, test.action(), expected);
+    if (temperature != previous_temperature || test.action() != previous_action)
+      expected_publishes++;
+    previous_temperature = temperature;
+    previous_action = test.action();
+  }
+  EXPECT(mismatches == 0);
+  EXPECT(test.publishes == expected_publishes);
+}
+
+/// Minimum run and off times delay a transition until their timer expires, without another sensor update.
+static void test_timers() {
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  auto &test = *new TestThermostat("Timers", climate::CLIMATE_MODE_HEAT_COOL);
+  test.thermostat.set_cooling_minimum_run_time_in_sec(60);
+  test.thermostat.set_cooling_minimum_off_time_in_sec(120);
+  test.setup();
+
+  test.set_temperature(0, 25.0f);
+  EXPECT(test.action() == climate::CLIMATE_ACTION_COOLING);
+  test.set_temperature(10000, 23.0f);
+  EXPECT(test.action() == climate::CLIMATE_ACTION_COOLING);
+  host_test::advance_to(60000);
+  EXPECT(test.action() == climate::CLIMATE_ACTION_IDLE);
+
+  test.set_temperature(70000, 25.0f);
+  EXPECT(test.action() == climate::CLIMATE_ACTION_IDLE);
+  host_test::advance_to(180000);
+  EXPECT(test.action() == climate::CLIMATE_ACTION_COOLING);
+
+  // An unchanged temperature doesn't publish again
+  int publishes = test.publishes;
+  test.set_temperature(190000, 25.0f);
+  EXPECT(test.publishes == publishes);
+}
+
+int main() {
+  test_trace("Heat cool", climate::CLIMATE_MODE_HEAT_COOL);
+  test_trace("Cool", climate::CLIMATE_MODE_COOL);
+  test_trace("Heat", climate::CLIMATE_MODE_HEAT);
+  test_timers();
+  return host_test::finish();
+}
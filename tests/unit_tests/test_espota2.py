@@ -0,0 +1,75 @@
+import hashlib
+import random
+
+import pytest
+
+from esphome import espota2
+
+
+def _image(seed, size):
+    rng = random.Random(seed)
+    return bytes(rng.getrandbits(8) for _ in range(size))
+
+
+def _modified(base):
+    # Change a few bytes, insert and remove regions, like a rebuilt firmware
+    target = bytearray(base)
+    target[100:104] = b"\x01\x02\x03\x04"
+    target[5000:5000] = _image(1, 300)
+    del target[20000:20500]
+    target += _image(2, 1000)
+    return bytes(target)
+
+
+@pytest.mark.parametrize(
+    "base, target",
+    (
+        (b"", b""),
+        (b"", b"new image"),
+        (b"old image", b""),
+        (_image(0, 50000), _image(0, 50000)),
+        (_image(0, 50000), _modified(_image(0, 50000))),
+        (_image(0, 50000), _image(3, 10000)),
+    ),
+)
+def test_delta_round_trip(base, target):
+    patch = espota2.generate_delta(base, target)
+
+    assert espota2.apply_delta(base, patch) == target
+
+
+def test_delta_is_small_for_similar_images():
+    base = _image(0, 50000)
+    target = _modified(base)
+
+    patch = espota2.generate_delta(base, target)
+
+    assert len(patch) < 2000
+
+
+@pytest.mark.parametrize(
+    "patch",
+    (
+        b"XXXX\x00",
+        espota2.DELTA_MAGIC + b"\x03",
+        espota2.DELTA_MAGIC + b"\x01\x00\x00\x00\x00\x00\x00\x01\x00\x00",
+        espota2.DELTA_MAGIC + b"\x00trailing",
+    ),
+)
+def test_apply_delta_rejects_invalid_patches(patch):
+    with pytest.raises(ValueError):
+        espota2.apply_delta(b"\x00" * 16, patch)
+
+
+def test_delta_base_cache(tmp_path):
+    filename = str(tmp_path / "firmware.bin")
+    images = [_image(seed, 100) for seed in range(espota2.DELTA_CACHE_SIZE + 1)]
+    for image in images:
+        espota2.store_delta_base(filename, image)
+
+    md5s = [hashlib.md5(image).hexdigest() for image in images]
+    assert espota2.load_delta_base(filename, md5s[-1]) == images[-1]
+    assert espota2.load_delta_base(filename, "0" * 32) is None
+    assert len(list((tmp_path / espota2.DELTA_CACHE_DIR).iterdir())) <= (
+        espota2.DELTA_CACHE_SIZE
+    )